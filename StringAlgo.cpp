@@ -3,6 +3,8 @@
 #include <span>
 #include <cassert>
 #include <iostream>
+#include <locale>
+#include <memory>
 #include<vector>
 #include<string>
 
@@ -128,6 +130,19 @@ int main()
 
 	test_str = "hello world";
 	string_algo::replace_all(test_str, "l", "LL");
+
+	// Tables of locales built for a single use are released
+	{
+		std::weak_ptr<const string_algo::algorithm::detail::ctype_table> table;
+		for (int i = 0; i < 1000; ++i)
+		{
+			std::locale loc(std::locale::classic(), new std::ctype<char>);
+			string_algo::to_lower_copy(test_str, loc);
+			string_algo::to_lower_copy(test_str, std::locale::classic());
+			if (i == 0) table = string_algo::algorithm::detail::get_ctype_table(loc);
+		}
+		assert(table.expired());
+	}
 	
 	std::cout << "Hello World!\n";
 }
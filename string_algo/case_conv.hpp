@@ -5,13 +5,19 @@
 
 #include <algorithm>
 #include <locale>
+#include <type_traits>
 
+#include "as_literal.hpp"
 #include "detail/case_conv.hpp"
 
 /*! \file
 	Defines sequence case-conversion algorithms.
 	Algorithms convert each element in the input sequence to the
 	desired case using provided locales.
+
+	Byte strings in locales, which convert the ASCII range like the
+	classic locale, are converted 16 bytes at a time. Bytes above 0x7F
+	are converted by the case tables of the locale.
 */
 namespace string_algo
 {
@@ -43,11 +49,13 @@ namespace string_algo
 				const RangeT& Input,
 				const std::locale& Loc = std::locale())
 		{
-			return ::string_algo::algorithm::detail::transform_range_copy(
+			auto lit_input = ::string_algo::as_literal(Input);
+
+			return ::string_algo::algorithm::detail::case_conv_copy<false>(
 				Output,
-				::string_algo::as_literal(Input),
-				::string_algo::algorithm::detail::to_lowerF<
-				typename RangeT::value_type >(Loc));
+				lit_input.data(),
+				lit_input.data() + lit_input.size(),
+				Loc);
 		}
 
 		//! Convert to lower case
@@ -59,9 +67,7 @@ namespace string_algo
 			const SequenceT& Input,
 			const std::locale& Loc = std::locale())
 		{
-			return  algorithm::detail::transform_range_copy<SequenceT>(
-				Input,
-				algorithm::detail::to_lowerF<typename SequenceT::value_type>(Loc));
+			return ::string_algo::algorithm::detail::case_conv_sequence_copy<false>(Input, Loc);
 		}
 
 		//! Convert to lower case
@@ -77,10 +83,14 @@ namespace string_algo
 			WritableRangeT& Input,
 			const std::locale& Loc = std::locale())
 		{
-			::string_algo::algorithm::detail::transform_range(
-				::string_algo::as_literal(Input),
-				::string_algo::algorithm::detail::to_lowerF<
-				typename WritableRangeT::value_type >(Loc));
+			auto lit_input = ::string_algo::as_literal(Input);
+			typedef std::remove_const_t<typename decltype(lit_input)::element_type> char_type;
+
+			::string_algo::algorithm::detail::case_converter<false, char_type> Converter(Loc);
+			Converter(
+				lit_input.data(),
+				lit_input.data() + lit_input.size(),
+				lit_input.data());
 		}
 
 		//  to_upper  -----------------------------------------------//
@@ -107,11 +117,13 @@ namespace string_algo
 				const RangeT& Input,
 				const std::locale& Loc = std::locale())
 		{
-			return ::string_algo::algorithm::detail::transform_range_copy(
+			auto lit_input = ::string_algo::as_literal(Input);
+
+			return ::string_algo::algorithm::detail::case_conv_copy<true>(
 				Output,
-				::string_algo::as_literal(Input),
-				::string_algo::algorithm::detail::to_upperF<
-				typename RangeT::value_type >(Loc));
+				lit_input.data(),
+				lit_input.data() + lit_input.size(),
+				Loc);
 		}
 
 		//! Convert to upper case
@@ -123,9 +135,7 @@ namespace string_algo
 			const SequenceT& Input,
 			const std::locale& Loc = std::locale())
 		{
-			return algorithm::detail::transform_range_copy<SequenceT>(
-				Input,
-				algorithm::detail::to_upperF<typename SequenceT::value_type>(Loc));
+			return ::string_algo::algorithm::detail::case_conv_sequence_copy<true>(Input, Loc);
 		}
 
 		//! Convert to upper case
@@ -141,10 +151,14 @@ namespace string_algo
 			WritableRangeT& Input,
 			const std::locale& Loc = std::locale())
 		{
-			::string_algo::algorithm::detail::transform_range(
-				::string_algo::as_literal(Input),
-				::string_algo::algorithm::detail::to_upperF<
-				typename WritableRangeT::value_type >(Loc));
+			auto lit_input = ::string_algo::as_literal(Input);
+			typedef std::remove_const_t<typename decltype(lit_input)::element_type> char_type;
+
+			::string_algo::algorithm::detail::case_converter<true, char_type> Converter(Loc);
+			Converter(
+				lit_input.data(),
+				lit_input.data() + lit_input.size(),
+				lit_input.data());
 		}
 
 	} // namespace algorithm
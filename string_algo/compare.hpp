@@ -5,6 +5,8 @@
 
 #include <locale>
 
+#include "detail/ctype_table.hpp"
+
 /*! \file
 	Defines element comparison predicates. Many algorithms in this library can
 	take an additional argument with a predicate used to compare elements.
@@ -38,7 +40,8 @@ namespace string_algo {
 		//! case insensitive version of is_equal
 		/*!
 			Case insensitive comparison predicate. Comparison is done using
-			specified locales.
+			specified locales. Narrow characters are converted through the case
+			table of the locale, which is built once and shared by all predicates.
 		*/
 		struct is_iequal
 		{
@@ -47,7 +50,7 @@ namespace string_algo {
 				\param Loc locales used for comparison
 			*/
 			is_iequal(const std::locale& Loc = std::locale()) :
-				m_Loc(Loc) {}
+				m_Table(detail::get_ctype_table(Loc)) {}
 
 			//! Function operator
 			/*!
@@ -56,15 +59,11 @@ namespace string_algo {
 			template< typename T1, typename T2 >
 			bool operator()(const T1& Arg1, const T2& Arg2) const
 			{
-#if defined(BORLANDC) && (BORLANDC >= 0x560) && (BORLANDC <= 0x564) && !defined(_USE_OLD_RW_STL)
-				return std::toupper(Arg1) == std::toupper(Arg2);
-#else
-				return std::toupper<T1>(Arg1, m_Loc) == std::toupper<T2>(Arg2, m_Loc);
-#endif
+				return m_Table->toupper(Arg1) == m_Table->toupper(Arg2);
 			}
 
 		private:
-			std::locale m_Loc;
+			detail::ctype_table_ptr m_Table;
 		};
 
 		//  is_less functor  -----------------------------------------------//
@@ -100,7 +99,7 @@ namespace string_algo {
 				\param Loc locales used for comparison
 			*/
 			is_iless(const std::locale& Loc = std::locale()) :
-				m_Loc(Loc) {}
+				m_Table(detail::get_ctype_table(Loc)) {}
 
 			//! Function operator
 			/*!
@@ -109,15 +108,11 @@ namespace string_algo {
 			template< typename T1, typename T2 >
 			bool operator()(const T1& Arg1, const T2& Arg2) const
 			{
-#if defined(BORLANDC) && (BORLANDC >= 0x560) && (BORLANDC <= 0x564) && !defined(_USE_OLD_RW_STL)
-				return std::toupper(Arg1) < std::toupper(Arg2);
-#else
-				return std::toupper<T1>(Arg1, m_Loc) < std::toupper<T2>(Arg2, m_Loc);
-#endif
+				return m_Table->toupper(Arg1) < m_Table->toupper(Arg2);
 			}
 
 		private:
-			std::locale m_Loc;
+			detail::ctype_table_ptr m_Table;
 		};
 
 		//  is_not_greater functor  -----------------------------------------------//
@@ -153,7 +148,7 @@ namespace string_algo {
 				\param Loc locales used for comparison
 			*/
 			is_not_igreater(const std::locale& Loc = std::locale()) :
-				m_Loc(Loc) {}
+				m_Table(detail::get_ctype_table(Loc)) {}
 
 			//! Function operator
 			/*!
@@ -162,15 +157,11 @@ namespace string_algo {
 			template< typename T1, typename T2 >
 			bool operator()(const T1& Arg1, const T2& Arg2) const
 			{
-#if defined(BORLANDC) && (BORLANDC >= 0x560) && (BORLANDC <= 0x564) && !defined(_USE_OLD_RW_STL)
-				return std::toupper(Arg1) <= std::toupper(Arg2);
-#else
-				return std::toupper<T1>(Arg1, m_Loc) <= std::toupper<T2>(Arg2, m_Loc);
-#endif
+				return m_Table->toupper(Arg1) <= m_Table->toupper(Arg2);
 			}
 
 		private:
-			std::locale m_Loc;
+			detail::ctype_table_ptr m_Table;
 		};
 
 
@@ -15,11 +15,37 @@ namespace string_algo {
 			token_compress_off  //!< Do not compress adjacent tokens
 		};
 
+		//! Line end mode
+		/*!
+			Specifies the handling of a carriage return preceding
+			the line feed in the line_iterator.
+		*/
+		enum line_cr_mode_type
+		{
+			line_strip_cr,    //!< Remove a trailing '\r' from every line
+			line_keep_cr      //!< Keep the line contents intact
+		};
+
+		//! Multi-pattern match selection mode
+		/*!
+			Specifies which match is selected by a multi-pattern search, when several
+			patterns match at the leftmost position.
+		*/
+		enum match_select_mode_type
+		{
+			match_leftmost_longest,   //!< Select the longest match
+			match_leftmost_first      //!< Select the match of the pattern given first
+		};
+
 	} // namespace algorithm
 
 	// pull the names to the boost namespace
 	using algorithm::token_compress_on;
 	using algorithm::token_compress_off;
+	using algorithm::line_strip_cr;
+	using algorithm::line_keep_cr;
+	using algorithm::match_leftmost_longest;
+	using algorithm::match_leftmost_first;
 
 } // namespace string_algo 
 
@@ -0,0 +1,254 @@
+
+#ifndef STRING_AHO_CORASICK_DETAIL_HPP
+#define STRING_AHO_CORASICK_DETAIL_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../constants.hpp"
+#include "simd.hpp"
+
+namespace string_algo {
+    namespace algorithm {
+        namespace detail {
+
+//  multi-pattern automaton  --------------------------------------------------//
+
+            // Match of a multi-pattern search
+            struct multi_match
+            {
+                std::size_t begin;
+                std::size_t end;
+                std::size_t pattern;
+            };
+
+            // Aho-Corasick automaton with leftmost match semantics
+            /*
+                The trie of the patterns is completed by failure links. Every state
+                knows the longest pattern, which is a suffix of the state's string.
+                For byte characters, the transitions are compiled into a dense table
+                and the search skips to the next possible pattern start by a vector
+                scan whenever the automaton is in the root state.
+
+                Matches are reported leftmost first. Among matches starting at the same
+                position, the longest one or the one with the lowest pattern index is
+                selected, according to the match mode. Empty patterns are ignored.
+            */
+            template< typename CharT >
+            class aho_corasick
+            {
+            public:
+                typedef std::basic_string_view<CharT> view_type;
+                typedef std::uint32_t state_type;
+
+                static constexpr state_type root=0;
+                static constexpr std::size_t npos=static_cast<std::size_t>(-1);
+
+            public:
+                aho_corasick() : m_eMode(match_leftmost_longest)
+                {
+                    m_States.push_back( state() );
+                }
+
+                // Add a pattern. Patterns are indexed in the order of addition.
+                void insert( view_type Pattern )
+                {
+                    std::size_t Index=m_Lengths.size();
+                    m_Lengths.push_back( Pattern.size() );
+                    if( Pattern.empty() ) return;
+
+                    state_type State=root;
+                    for( CharT Ch : Pattern )
+                    {
+                        state_type Next=child( State, Ch );
+                        if( Next==root )
+                        {
+                            Next=static_cast<state_type>( m_States.size() );
+                            m_States.push_back( state() );
+                            m_States[Next].depth=m_States[State].depth+1;
+                            m_States[State].edges.emplace_back( Ch, Next );
+                        }
+                        State=Next;
+                    }
+
+                    // Duplicate patterns, the first one wins
+                    if( m_States[State].own==npos )
+                    {
+                        m_States[State].own=Index;
+                    }
+                }
+
+                // Compute failure links and outputs, build the transition table
+                void compile( match_select_mode_type eMode )
+                {
+                    m_eMode=eMode;
+
+                    // Breadth first traversal
+                    std::vector<state_type> Queue;
+                    Queue.reserve( m_States.size() );
+
+                    m_States[root].output=m_States[root].own;
+                    for( const edge_type& Edge : m_States[root].edges )
+                    {
+                        m_States[Edge.second].fail=root;
+                        Queue.push_back( Edge.second );
+                    }
+
+                    for( std::size_t Head=0; Head<Queue.size(); ++Head )
+                    {
+                        state_type State=Queue[Head];
+                        state& Current=m_States[State];
+
+                        Current.output=( Current.own!=npos ) ? Current.own : m_States[Current.fail].output;
+
+                        for( const edge_type& Edge : Current.edges )
+                        {
+                            state_type Fail=Current.fail;
+                            state_type Target=child( Fail, Edge.first );
+                            while( Target==root && Fail!=root )
+                            {
+                                Fail=m_States[Fail].fail;
+                                Target=child( Fail, Edge.first );
+                            }
+                            m_States[Edge.second].fail=( Target==Edge.second ) ? root : Target;
+                            Queue.push_back( Edge.second );
+                        }
+                    }
+
+                    if constexpr( is_byte_char<CharT>::value )
+                    {
+                        // Dense transition table, filled in the breadth first order
+                        m_Delta.assign( m_States.size()*256, root );
+                        for( const edge_type& Edge : m_States[root].edges )
+                        {
+                            m_Delta[static_cast<unsigned char>(Edge.first)]=Edge.second;
+                            m_First.insert( static_cast<unsigned char>(Edge.first) );
+                        }
+                        for( state_type State : Queue )
+                        {
+                            state_type* Row=&m_Delta[std::size_t(State)*256];
+                            const state_type* FailRow=&m_Delta[std::size_t(m_States[State].fail)*256];
+                            std::copy( FailRow, FailRow+256, Row );
+                            for( const edge_type& Edge : m_States[State].edges )
+                            {
+                                Row[static_cast<unsigned char>(Edge.first)]=Edge.second;
+                            }
+                        }
+                    }
+                }
+
+                // Number of patterns
+                std::size_t size() const { return m_Lengths.size(); }
+
+                // Find the leftmost match in [From, Input.size())
+                /*
+                    Returns a match with pattern==npos if there is none.
+                */
+                multi_match find( view_type Input, std::size_t From ) const
+                {
+                    multi_match Match={ Input.size(), Input.size(), npos };
+
+                    const CharT* Data=Input.data();
+                    std::size_t Size=Input.size();
+                    state_type State=root;
+
+                    for( std::size_t Pos=From; Pos<Size; )
+                    {
+                        if constexpr( is_byte_char<CharT>::value )
+                        {
+                            if( State==root && Match.pattern==npos )
+                            {
+                                // Skip to the next possible start of a pattern
+                                Pos=static_cast<std::size_t>(
+                                    ::string_algo::algorithm::detail::find_first_of_set( Data+Pos, Data+Size, m_First )-Data );
+                                if( Pos==Size ) break;
+                            }
+                        }
+
+                        State=next( State, Data[Pos] );
+                        ++Pos;
+
+                        const state& Current=m_States[State];
+                        if( Match.pattern!=npos && Pos-Current.depth>Match.begin )
+                        {
+                            // No later match can start at or before the current one
+                            return Match;
+                        }
+
+                        if( Current.output!=npos )
+                        {
+                            std::size_t Begin=Pos-m_Lengths[Current.output];
+                            if( Match.pattern==npos || Begin<Match.begin ||
+                                ( Begin==Match.begin && m_eMode==match_leftmost_longest ) ||
+                                ( Begin==Match.begin && Current.output<Match.pattern ) )
+                            {
+                                Match.begin=Begin;
+                                Match.end=Pos;
+                                Match.pattern=Current.output;
+                            }
+                        }
+                    }
+
+                    return Match;
+                }
+
+            private:
+                typedef std::pair<CharT, state_type> edge_type;
+
+                struct state
+                {
+                    state() : fail(root), depth(0), own(npos), output(npos) {}
+
+                    std::vector<edge_type> edges;
+                    state_type fail;
+                    std::size_t depth;
+                    std::size_t own;        // pattern ending in this state
+                    std::size_t output;     // longest pattern, which is a suffix of the state
+                };
+
+                // Trie edge, root if there is none
+                state_type child( state_type State, CharT Ch ) const
+                {
+                    for( const edge_type& Edge : m_States[State].edges )
+                    {
+                        if( Edge.first==Ch ) return Edge.second;
+                    }
+                    return root;
+                }
+
+                // Automaton transition
+                state_type next( state_type State, CharT Ch ) const
+                {
+                    if constexpr( is_byte_char<CharT>::value )
+                    {
+                        return m_Delta[std::size_t(State)*256+static_cast<unsigned char>(Ch)];
+                    }
+                    else
+                    {
+                        for(;;)
+                        {
+                            state_type Next=child( State, Ch );
+                            if( Next!=root || State==root ) return Next;
+                            State=m_States[State].fail;
+                        }
+                    }
+                }
+
+            private:
+                std::vector<state> m_States;
+                std::vector<std::size_t> m_Lengths;
+                std::vector<state_type> m_Delta;
+                byte_set m_First;
+                match_select_mode_type m_eMode;
+            };
+
+        } // namespace detail
+    } // namespace algorithm
+} // namespace string_algo
+
+#endif  // STRING_AHO_CORASICK_DETAIL_HPP
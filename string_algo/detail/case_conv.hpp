@@ -3,10 +3,18 @@
 #ifndef STRING_CASE_CONV_DETAIL_HPP
 #define STRING_CASE_CONV_DETAIL_HPP
 
+#include <algorithm>
+#include <cstddef>
 #include <locale>
 #include <functional>
+#include <iterator>
+#include <ranges>
 #include <type_traits>
 
+#include "ctype_table.hpp"
+#include "sequence.hpp"
+#include "simd.hpp"
+
 namespace string_algo
 {
 	namespace algorithm
@@ -28,19 +36,15 @@ namespace string_algo
 				typedef CharT argument_type;
 				typedef CharT result_type;
 				// Constructor
-				to_lowerF(const std::locale& Loc) : m_Loc(&Loc) {}
+				to_lowerF(const std::locale& Loc) : m_Table(get_ctype_table(Loc)) {}
 
 				// Operation
 				CharT operator ()(CharT Ch) const
 				{
-#if defined(BORLANDC) && (BORLANDC >= 0x560) && (BORLANDC <= 0x564) && !defined(_USE_OLD_RW_STL)
-					return std::tolower(static_cast<typename boost::make_unsigned <CharT>::type> (Ch));
-#else
-					return std::tolower<CharT>(Ch, *m_Loc);
-#endif
+					return m_Table->tolower(Ch);
 				}
 			private:
-				const std::locale* m_Loc;
+				ctype_table_ptr m_Table;
 			};
 
 			// a toupper functor
@@ -50,25 +54,189 @@ namespace string_algo
 				typedef CharT argument_type;
 				typedef CharT result_type;
 				// Constructor
-				to_upperF(const std::locale& Loc) : m_Loc(&Loc) {}
+				to_upperF(const std::locale& Loc) : m_Table(get_ctype_table(Loc)) {}
 
 				// Operation
 				CharT operator ()(CharT Ch) const
 				{
-#if defined(BORLANDC) && (BORLANDC >= 0x560) && (BORLANDC <= 0x564) && !defined(_USE_OLD_RW_STL)
-					return std::toupper(static_cast<typename boost::make_unsigned <CharT>::type> (Ch));
-#else
-					return std::toupper<CharT>(Ch, *m_Loc);
-#endif
+					return m_Table->toupper(Ch);
 				}
 			private:
-				const std::locale* m_Loc;
+				ctype_table_ptr m_Table;
 			};
 
 
 			//#pragma warning(pop)
 
 
+			//  case converter  --------------------------------------------------------//
+
+#if defined(STRING_ALGO_SSE2)
+			// ASCII case conversion of a block
+			/*
+				The letter range is shifted to the bottom of the signed byte range,
+				so that a single signed compare selects the letters of a block.
+			*/
+			template<bool Upper>
+			inline __m128i ascii_case_block(__m128i Block)
+			{
+				const __m128i Shift = _mm_set1_epi8(static_cast<char>(0x80 - (Upper ? 'a' : 'A')));
+				const __m128i Limit = _mm_set1_epi8(static_cast<char>(-128 + 26));
+				const __m128i Flip = _mm_set1_epi8(0x20);
+
+				__m128i Letters = _mm_cmplt_epi8(_mm_add_epi8(Block, Shift), Limit);
+				return _mm_xor_si128(Block, _mm_and_si128(Letters, Flip));
+			}
+#endif
+
+			// ASCII case conversion of [First,Last) to Output
+			/*
+				Letters A-Z (a-z) are converted, other bytes are copied unchanged.
+			*/
+			template<bool Upper, typename CharT>
+			inline void ascii_case_bytes(const CharT* First, const CharT* Last, CharT* Output)
+			{
+				static_assert(is_byte_char<CharT>::value, "byte character type required");
+
+				const unsigned char Low = Upper ? 'a' : 'A';
+
+#if defined(STRING_ALGO_SSE2)
+				for (; Last - First >= 16; First += 16, Output += 16)
+				{
+					__m128i Block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(First));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(Output), ascii_case_block<Upper>(Block));
+				}
+#endif
+
+				for (; First != Last; ++First, ++Output)
+				{
+					unsigned char Ch = static_cast<unsigned char>(*First);
+					*Output = static_cast<CharT>(static_cast<unsigned char>(Ch - Low) < 26 ? Ch ^ 0x20 : Ch);
+				}
+			}
+
+			// Case converter of contiguous ranges
+			/*
+				Uses the shared ctype table of the locale. For char, locales, which
+				convert the ASCII range like the classic locale (e.g. "C", "POSIX",
+				UTF-8 and most single byte locales), are converted by the ASCII kernel.
+				Bytes above 0x7F are then translated through the table of the locale,
+				unless the locale leaves them unchanged, as UTF-8 locales do.
+				Other locales and character types use the array conversion of the facet.
+			*/
+			template<bool Upper, typename CharT>
+			class case_converter
+			{
+			public:
+				// Constructor
+				explicit case_converter(const std::locale& Loc) :
+					m_Table(get_ctype_table(Loc)) {}
+
+				// Convert [First,Last) to Output, Output may be equal to First
+				void operator()(const CharT* First, const CharT* Last, CharT* Output) const
+				{
+					if constexpr (std::is_same_v<CharT, char>)
+					{
+						if (m_Table->ascii_case())
+						{
+							ascii_case_bytes<Upper>(First, Last, Output);
+							if (!m_Table->high_case_identity())
+							{
+								const unsigned char* Map = Upper ? m_Table->upper_table() : m_Table->lower_table();
+								for (CharT* It = Output; It != Output + (Last - First); ++It)
+								{
+									unsigned char Ch = static_cast<unsigned char>(*It);
+									if (Ch >= 0x80) *It = static_cast<CharT>(Map[Ch]);
+								}
+							}
+							return;
+						}
+					}
+
+					if (First != Output)
+					{
+						std::copy(First, Last, Output);
+					}
+					if (Upper)
+					{
+						m_Table->template facet<CharT>().toupper(Output, Output + (Last - First));
+					}
+					else
+					{
+						m_Table->template facet<CharT>().tolower(Output, Output + (Last - First));
+					}
+				}
+
+			private:
+				ctype_table_ptr m_Table;
+			};
+
+			// Case conversion of a range to an output iterator
+			/*
+				Pointer outputs are written directly, other outputs receive
+				the result in converted chunks.
+			*/
+			template<bool Upper, typename OutputIteratorT, typename CharT>
+			inline OutputIteratorT case_conv_copy(
+				OutputIteratorT Output,
+				const CharT* First,
+				const CharT* Last,
+				const std::locale& Loc)
+			{
+				typedef std::remove_const_t<CharT> char_type;
+
+				case_converter<Upper, char_type> Converter(Loc);
+				if constexpr (std::is_same_v<OutputIteratorT, char_type*>)
+				{
+					Converter(First, Last, Output);
+					return Output + (Last - First);
+				}
+				else
+				{
+					char_type Buffer[256];
+					while (First != Last)
+					{
+						const CharT* Next = First + std::min<std::ptrdiff_t>(Last - First, 256);
+						Converter(First, Next, Buffer);
+						Output = std::copy(Buffer, Buffer + (Next - First), Output);
+						First = Next;
+					}
+					return Output;
+				}
+			}
+
+			// Case conversion of a sequence
+			/*
+				Contiguous sequences are allocated with the size of the input
+				and converted directly.
+			*/
+			template<bool Upper, typename SequenceT>
+			inline SequenceT case_conv_sequence_copy(const SequenceT& Input, const std::locale& Loc)
+			{
+				typedef typename SequenceT::value_type char_type;
+
+				SequenceT Output;
+				if constexpr (is_contiguous_sequence<SequenceT>::value)
+				{
+					const char_type* Data = std::ranges::data(Input);
+					std::size_t Size = std::ranges::size(Input);
+
+					resize_and_fill(Output, Size,
+						[&](char_type* Target)
+						{
+							case_converter<Upper, char_type> Converter(Loc);
+							Converter(Data, Data + Size, Target);
+						});
+				}
+				else
+				{
+					reserve(Output, std::ranges::size(Input));
+					typedef std::conditional_t<Upper, to_upperF<char_type>, to_lowerF<char_type> > functor_type;
+					std::transform(std::begin(Input), std::end(Input), std::back_inserter(Output), functor_type(Loc));
+				}
+				return Output;
+			}
+
 			// algorithm implementation -------------------------------------------------------------------------
 
 			// Transform a range
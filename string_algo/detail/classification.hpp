@@ -7,7 +7,9 @@
 #include <locale>
 #include <type_traits>
 
+#include "ctype_table.hpp"
 #include "predicate_facade.hpp"
+
 namespace string_algo
 {
 	namespace algorithm
@@ -26,25 +28,20 @@ namespace string_algo
 
 				// Constructor from a locale
 				is_classifiedF(std::ctype_base::mask Type, std::locale const& Loc = std::locale()) :
-					m_Type(Type), m_Locale(Loc) {}
+					m_Type(Type), m_Table(get_ctype_table(Loc)) {}
 				// Operation
+				/*
+					Narrow characters are classified by the mask table of the locale
+				*/
 				template<typename CharT>
 				bool operator()(CharT Ch) const
 				{
-					return std::use_facet< std::ctype<CharT> >(m_Locale).is(m_Type, Ch);
-				}
-
-#if defined(BORLANDC) && (BORLANDC >= 0x560) && (BORLANDC <= 0x582) && !defined(_USE_OLD_RW_STL)
-				template<>
-				bool operator()(char const Ch) const
-				{
-					return std::use_facet< std::ctype<char> >(m_Locale).is(m_Type, Ch);
+					return m_Table->is(m_Type, Ch);
 				}
-#endif
 
 			private:
 				std::ctype_base::mask m_Type;
-				std::locale m_Locale;
+				ctype_table_ptr m_Table;
 			};
 
 
@@ -0,0 +1,205 @@
+
+#ifndef STRING_CTYPE_TABLE_DETAIL_HPP
+#define STRING_CTYPE_TABLE_DETAIL_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <locale>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <vector>
+
+namespace string_algo {
+    namespace algorithm {
+        namespace detail {
+
+//  ctype table  -----------------------------------------------------------//
+
+            // Classification and case tables of a locale
+            /*
+                Narrow characters are classified and converted by 256 entry
+                tables built from the ctype<char> facet. Other character types
+                use the facets of the locale, ctype<wchar_t> is looked up once.
+
+                The table keeps a copy of its locale, so the facets stay alive
+                as long as the table.
+            */
+            class ctype_table
+            {
+            public:
+                typedef std::ctype_base::mask mask_type;
+
+            public:
+                explicit ctype_table( const std::locale& Loc ) :
+                    m_Locale( Loc ),
+                    m_Narrow( &std::use_facet< std::ctype<char> >( Loc ) ),
+                    m_Wide( std::has_facet< std::ctype<wchar_t> >( Loc ) ? &std::use_facet< std::ctype<wchar_t> >( Loc ) : 0 )
+                {
+                    char Chars[256];
+                    for( unsigned int Ch=0; Ch<256; ++Ch )
+                    {
+                        Chars[Ch]=static_cast<char>(Ch);
+                    }
+
+                    m_Narrow->is( Chars, Chars+256, m_Mask );
+
+                    char Lower[256];
+                    char Upper[256];
+                    std::copy( Chars, Chars+256, Lower );
+                    std::copy( Chars, Chars+256, Upper );
+                    m_Narrow->tolower( Lower, Lower+256 );
+                    m_Narrow->toupper( Upper, Upper+256 );
+
+                    m_bAsciiCase=true;
+                    m_bHighCaseIdentity=true;
+                    for( unsigned int Ch=0; Ch<256; ++Ch )
+                    {
+                        m_Lower[Ch]=static_cast<unsigned char>(Lower[Ch]);
+                        m_Upper[Ch]=static_cast<unsigned char>(Upper[Ch]);
+
+                        if( Ch<128 )
+                        {
+                            unsigned int AsciiLower=( Ch>='A' && Ch<='Z' ) ? Ch+0x20 : Ch;
+                            unsigned int AsciiUpper=( Ch>='a' && Ch<='z' ) ? Ch-0x20 : Ch;
+                            m_bAsciiCase=m_bAsciiCase && m_Lower[Ch]==AsciiLower && m_Upper[Ch]==AsciiUpper;
+                        }
+                        else
+                        {
+                            m_bHighCaseIdentity=m_bHighCaseIdentity && m_Lower[Ch]==Ch && m_Upper[Ch]==Ch;
+                        }
+                    }
+                }
+
+                const std::locale& locale() const { return m_Locale; }
+
+                // Check if the table was built for the facets of a locale
+                bool matches( const std::ctype<char>* Narrow, const std::ctype<wchar_t>* Wide ) const
+                {
+                    return m_Narrow==Narrow && m_Wide==Wide;
+                }
+
+                // Classification
+                bool is( mask_type Type, char Ch ) const
+                {
+                    return ( m_Mask[static_cast<unsigned char>(Ch)] & Type )!=0;
+                }
+
+                template< typename CharT >
+                bool is( mask_type Type, CharT Ch ) const
+                {
+                    return facet<CharT>().is( Type, Ch );
+                }
+
+                // Case conversion
+                char tolower( char Ch ) const { return static_cast<char>( m_Lower[static_cast<unsigned char>(Ch)] ); }
+                char toupper( char Ch ) const { return static_cast<char>( m_Upper[static_cast<unsigned char>(Ch)] ); }
+
+                template< typename CharT >
+                CharT tolower( CharT Ch ) const { return facet<CharT>().tolower( Ch ); }
+
+                template< typename CharT >
+                CharT toupper( CharT Ch ) const { return facet<CharT>().toupper( Ch ); }
+
+                // Tables of the narrow case conversion
+                const unsigned char* lower_table() const { return m_Lower; }
+                const unsigned char* upper_table() const { return m_Upper; }
+
+                // Check if the ASCII range is converted like in the classic locale
+                bool ascii_case() const { return m_bAsciiCase; }
+
+                // Check if bytes above 0x7F are left unchanged by the case conversion
+                bool high_case_identity() const { return m_bHighCaseIdentity; }
+
+                // The ctype facet for a character type
+                template< typename CharT >
+                const std::ctype<CharT>& facet() const
+                {
+                    if constexpr( std::is_same_v<CharT, char> )
+                    {
+                        return *m_Narrow;
+                    }
+                    else if constexpr( std::is_same_v<CharT, wchar_t> )
+                    {
+                        return m_Wide ? *m_Wide : std::use_facet< std::ctype<wchar_t> >( m_Locale );
+                    }
+                    else
+                    {
+                        return std::use_facet< std::ctype<CharT> >( m_Locale );
+                    }
+                }
+
+            private:
+                std::locale m_Locale;
+                const std::ctype<char>* m_Narrow;
+                const std::ctype<wchar_t>* m_Wide;
+                mask_type m_Mask[256];
+                unsigned char m_Lower[256];
+                unsigned char m_Upper[256];
+                bool m_bAsciiCase;
+                bool m_bHighCaseIdentity;
+            };
+
+            // Shared ownership of a table
+            /*
+                Functors own their table, it stays valid after the registry
+                of get_ctype_table has dropped it.
+            */
+            typedef std::shared_ptr<const ctype_table> ctype_table_ptr;
+
+            // Number of tables kept by the registry of get_ctype_table
+            const std::size_t ctype_table_cache_size=8;
+
+            // Get the shared table of a locale
+            /*
+                Tables are built once per locale, i.e. per distinct pair of ctype<char>
+                and ctype<wchar_t> facets. The registry keeps the most recently used
+                tables, ordered by their last use, and drops the least recently used
+                one, when it is full. Locales, which are built for a single use,
+                do not accumulate therefore. The table used last by a thread is
+                found without locking. Equal locales have the same facets, the table
+                of an equal locale is reused.
+            */
+            inline ctype_table_ptr get_ctype_table( const std::locale& Loc )
+            {
+                // Copies of a locale compare equal without looking up the facets
+                thread_local ctype_table_ptr Last;
+                if( Last && Last->locale()==Loc )
+                {
+                    return Last;
+                }
+
+                const std::ctype<char>* Narrow=&std::use_facet< std::ctype<char> >( Loc );
+                const std::ctype<wchar_t>* Wide=std::has_facet< std::ctype<wchar_t> >( Loc ) ? &std::use_facet< std::ctype<wchar_t> >( Loc ) : 0;
+
+                // The registry is never destroyed, functors may outlive static objects.
+                // The tables keep their facets alive, so a cached facet address is not reused.
+                static std::mutex* Mutex=new std::mutex;
+                static std::vector<ctype_table_ptr>* Tables=new std::vector<ctype_table_ptr>;
+
+                std::lock_guard<std::mutex> Lock( *Mutex );
+                for( std::size_t Index=0; Index<Tables->size(); ++Index )
+                {
+                    if( (*Tables)[Index]->matches( Narrow, Wide ) )
+                    {
+                        // Move the table to the front
+                        std::rotate( Tables->begin(), Tables->begin()+Index, Tables->begin()+Index+1 );
+                        Last=Tables->front();
+                        return Last;
+                    }
+                }
+
+                if( Tables->size()==ctype_table_cache_size )
+                {
+                    Tables->pop_back();
+                }
+                Tables->insert( Tables->begin(), std::make_shared<const ctype_table>( Loc ) );
+                Last=Tables->front();
+                return Last;
+            }
+
+        } // namespace detail
+    } // namespace algorithm
+} // namespace string_algo
+
+#endif  // STRING_CTYPE_TABLE_DETAIL_HPP
@@ -0,0 +1,288 @@
+
+#ifndef STRING_ERASE_DETAIL_HPP
+#define STRING_ERASE_DETAIL_HPP
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+#include <type_traits>
+
+#include "sequence.hpp"
+#include "simd.hpp"
+
+namespace string_algo {
+    namespace algorithm {
+        namespace detail {
+
+//  erase_if compaction  ----------------------------------------------------//
+
+            // Minimal input size, for which the predicate is tabulated
+            /*
+                Tabulation evaluates the predicate for all 256 byte values.
+                Shorter inputs are filtered by the predicate directly.
+            */
+            const std::size_t erase_if_table_threshold=256;
+
+            // Selection of the members of a set to be removed by erase_if
+            struct erase_members_selector
+            {
+                // Bit mask of the bytes of a block to be removed
+                unsigned int block( unsigned int Members ) { return Members; }
+
+                // Check if a single character should be removed
+                bool single( bool bMember ) { return bMember; }
+            };
+
+            // Remove members of the set from [First,Last) in-place
+            /*
+                Output must be equal to First. Returns the end of the output.
+                Select decides, which members are removed, it is invoked for
+                the blocks and characters in order.
+
+                Inputs are processed in 16 byte blocks. A block without removed
+                bytes is stored as a whole, a block of removed bytes only is skipped.
+                Mixed blocks are compacted without branches, every byte is stored and
+                the output advances only past the kept ones. The stores of removed
+                bytes land in the consumed part of the input, a distinct output
+                would be written past the end of the result (see copy_members).
+            */
+            template< typename CharT, typename SelectorT >
+            inline CharT* compact_members(
+                const CharT* First,
+                const CharT* Last,
+                CharT* Output,
+                const byte_range_set& Set,
+                SelectorT Select )
+            {
+                static_assert( is_byte_char<CharT>::value, "byte character type required" );
+
+#if defined(STRING_ALGO_SSE2)
+                if( Set.is_vector() && Last-First>=16 )
+                {
+                    byte_range_vectors Vectors(Set);
+                    for( ; Last-First>=16; First+=16 )
+                    {
+                        __m128i Block=_mm_loadu_si128( reinterpret_cast<const __m128i*>(First) );
+                        unsigned int Mask=Select.block( Vectors.match( Block ) );
+
+                        if( Mask==0 )
+                        {
+                            _mm_storeu_si128( reinterpret_cast<__m128i*>(Output), Block );
+                            Output+=16;
+                        }
+                        else if( Mask!=0xFFFF )
+                        {
+                            for( unsigned int Index=0; Index<16; ++Index )
+                            {
+                                *Output=First[Index];
+                                Output+=( ~Mask>>Index ) & 1;
+                            }
+                        }
+                    }
+                }
+#endif
+
+                for( ; First!=Last; ++First )
+                {
+                    *Output=*First;
+                    Output+=!Select.single( Set.contains( static_cast<unsigned char>(*First) ) );
+                }
+
+                return Output;
+            }
+
+            // Copy the bytes of [First,Last), which are not removed members of the set, to Output
+            /*
+                Output is a distinct buffer, which needs room for the kept bytes
+                only. Returns the end of the output. Select is used as by
+                compact_members. The kept bytes of mixed blocks are extracted
+                from the bit mask, no removed byte is stored.
+            */
+            template< typename CharT, typename SelectorT >
+            inline CharT* copy_members(
+                const CharT* First,
+                const CharT* Last,
+                CharT* Output,
+                const byte_range_set& Set,
+                SelectorT Select )
+            {
+                static_assert( is_byte_char<CharT>::value, "byte character type required" );
+
+#if defined(STRING_ALGO_SSE2)
+                if( Set.is_vector() && Last-First>=16 )
+                {
+                    byte_range_vectors Vectors(Set);
+                    for( ; Last-First>=16; First+=16 )
+                    {
+                        __m128i Block=_mm_loadu_si128( reinterpret_cast<const __m128i*>(First) );
+                        unsigned int Mask=Select.block( Vectors.match( Block ) );
+
+                        if( Mask==0 )
+                        {
+                            _mm_storeu_si128( reinterpret_cast<__m128i*>(Output), Block );
+                            Output+=16;
+                        }
+                        else
+                        {
+                            for( unsigned int Keep=~Mask & 0xFFFF; Keep!=0; Keep&=Keep-1 )
+                            {
+                                *Output++=First[std::countr_zero(Keep)];
+                            }
+                        }
+                    }
+                }
+#endif
+
+                for( ; First!=Last; ++First )
+                {
+                    if( !Select.single( Set.contains( static_cast<unsigned char>(*First) ) ) )
+                    {
+                        *Output++=*First;
+                    }
+                }
+
+                return Output;
+            }
+
+            // Remove members of the set from [First,Last), storing the rest to Output
+            /*
+                Output may be equal to First (in-place compaction), or a distinct
+                buffer with room for the result.
+            */
+            template< typename CharT >
+            inline CharT* erase_compact(
+                const CharT* First,
+                const CharT* Last,
+                CharT* Output,
+                const byte_range_set& Set )
+            {
+                if( Output==First )
+                {
+                    return ::string_algo::algorithm::detail::compact_members( First, Last, Output, Set, erase_members_selector() );
+                }
+                return ::string_algo::algorithm::detail::copy_members( First, Last, Output, Set, erase_members_selector() );
+            }
+
+            // Remove characters satisfying the predicate from [First,Last), storing the rest to Output
+            /*
+                Output may be equal to First. Returns the end of the output.
+            */
+            template< typename CharT, typename PredicateT >
+            inline CharT* erase_if_compact(
+                const CharT* First,
+                const CharT* Last,
+                CharT* Output,
+                const PredicateT& Pred )
+            {
+                if constexpr( is_byte_char<CharT>::value )
+                {
+                    if( static_cast<std::size_t>(Last-First)>=erase_if_table_threshold )
+                    {
+                        return ::string_algo::algorithm::detail::erase_compact(
+                            First, Last, Output,
+                            byte_range_set::template from_predicate<CharT>( Pred ) );
+                    }
+                }
+
+                for( ; First!=Last; ++First )
+                {
+                    if( !Pred(*First) )
+                    {
+                        *Output++=*First;
+                    }
+                }
+
+                return Output;
+            }
+
+            // Copy [First,Last) to an output iterator, skipping characters satisfying the predicate
+            /*
+                Runs of kept characters are located by a vector scan and copied at once.
+            */
+            template< typename OutputIteratorT, typename CharT, typename PredicateT >
+            inline OutputIteratorT erase_if_copy_impl(
+                OutputIteratorT Output,
+                const CharT* First,
+                const CharT* Last,
+                const PredicateT& Pred )
+            {
+                typedef std::remove_const_t<CharT> char_type;
+
+                if constexpr( is_byte_char<char_type>::value )
+                {
+                    if( static_cast<std::size_t>(Last-First)>=erase_if_table_threshold )
+                    {
+                        if constexpr( std::is_same_v<OutputIteratorT, char_type*> )
+                        {
+                            return ::string_algo::algorithm::detail::erase_compact(
+                                First, Last, Output,
+                                byte_range_set::template from_predicate<char_type>( Pred ) );
+                        }
+                        else
+                        {
+                            byte_range_set Set=byte_range_set::template from_predicate<char_type>( Pred );
+                            while( First!=Last )
+                            {
+                                const CharT* Found=::string_algo::algorithm::detail::find_first_of_ranges( First, Last, Set );
+                                Output=std::copy( First, Found, Output );
+
+                                for( First=Found; First!=Last && Set.contains( static_cast<unsigned char>(*First) ); ++First ) {}
+                            }
+                            return Output;
+                        }
+                    }
+                }
+
+                return std::remove_copy_if( First, Last, Output, Pred );
+            }
+
+            // In-place erase_if
+            template< typename SequenceT, typename PredicateT >
+            inline void erase_if_impl( SequenceT& Input, const PredicateT& Pred )
+            {
+                if constexpr( is_contiguous_sequence<SequenceT>::value )
+                {
+                    auto* Data=std::ranges::data(Input);
+                    std::size_t Size=std::ranges::size(Input);
+
+                    auto* End=::string_algo::algorithm::detail::erase_if_compact( Data, Data+Size, Data, Pred );
+                    Input.resize( static_cast<std::size_t>(End-Data) );
+                }
+                else
+                {
+                    Input.erase( std::remove_if( ::std::begin(Input), ::std::end(Input), Pred ), ::std::end(Input) );
+                }
+            }
+
+            // Copy variant of erase_if returning a sequence
+            template< typename SequenceT, typename PredicateT >
+            inline SequenceT erase_if_copy_impl( const SequenceT& Input, const PredicateT& Pred )
+            {
+                SequenceT Output;
+
+                if constexpr( is_contiguous_sequence<SequenceT>::value )
+                {
+                    const auto* Data=std::ranges::data(Input);
+                    std::size_t Size=std::ranges::size(Input);
+
+                    ::string_algo::algorithm::detail::resize_and_truncate( Output, Size,
+                        [&]( auto* Target )
+                        {
+                            return ::string_algo::algorithm::detail::erase_if_compact( Data, Data+Size, Target, Pred )-Target;
+                        } );
+                }
+                else
+                {
+                    std::remove_copy_if( ::std::begin(Input), ::std::end(Input), std::back_inserter(Output), Pred );
+                }
+
+                return Output;
+            }
+
+        } // namespace detail
+    } // namespace algorithm
+} // namespace string_algo
+
+#endif  // STRING_ERASE_DETAIL_HPP
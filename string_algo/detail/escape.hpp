@@ -0,0 +1,459 @@
+
+#ifndef STRING_ESCAPE_DETAIL_HPP
+#define STRING_ESCAPE_DETAIL_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <span>
+#include <type_traits>
+
+#include "simd.hpp"
+#include "utf8.hpp"
+
+namespace string_algo {
+    namespace algorithm {
+        namespace detail {
+
+//  escape tables  -----------------------------------------------------------//
+
+            // Escape sequence of one character
+            /*
+                Size==0 marks a character, which is kept as it is.
+            */
+            struct escape_entry
+            {
+                unsigned char Size;
+                char Text[7];
+            };
+
+            // Escape sequences of all byte values
+            /*
+                Set holds the characters, which have an escape sequence.
+                It is used to locate them by a vector scan.
+            */
+            struct escape_table
+            {
+                escape_entry Entries[256];
+                byte_range_set Set;
+
+                const escape_entry& operator[]( unsigned char Ch ) const { return Entries[Ch]; }
+            };
+
+            // Upper case hexadecimal digit
+            inline constexpr char hex_digit( unsigned int Value )
+            {
+                return "0123456789ABCDEF"[Value & 0xF];
+            }
+
+            // Value of a hexadecimal digit, -1 if Ch is not a digit
+            template< typename CharT >
+            inline constexpr int hex_value( CharT Ch )
+            {
+                return
+                    ( Ch>='0' && Ch<='9' ) ? static_cast<int>( Ch-'0' ) :
+                    ( Ch>='a' && Ch<='f' ) ? static_cast<int>( Ch-'a'+10 ) :
+                    ( Ch>='A' && Ch<='F' ) ? static_cast<int>( Ch-'A'+10 ) : -1;
+            }
+
+            // Fill an escape entry from a literal
+            inline void set_escape( escape_table& Table, unsigned char Ch, const char* Text )
+            {
+                escape_entry& Entry=Table.Entries[Ch];
+                Entry.Size=0;
+                for( ; *Text!=0; ++Text )
+                {
+                    Entry.Text[Entry.Size++]=*Text;
+                }
+            }
+
+            // Build the character set of a table
+            inline void finish_escape_table( escape_table& Table )
+            {
+                Table.Set=byte_range_set::template from_predicate<unsigned char>(
+                    [&Table]( unsigned char Ch ) { return Table.Entries[Ch].Size!=0; } );
+            }
+
+            // JSON string escapes
+            /*
+                Quotation mark, reverse solidus and control characters are escaped.
+                Control characters without a short form are written as \u00XX.
+            */
+            inline const escape_table& json_escape_table()
+            {
+                static const escape_table Table=[]
+                {
+                    escape_table Result{};
+                    for( unsigned int Ch=0; Ch<0x20; ++Ch )
+                    {
+                        const char Text[]={ '\\', 'u', '0', '0', hex_digit(Ch>>4), hex_digit(Ch), 0 };
+                        set_escape( Result, static_cast<unsigned char>(Ch), Text );
+                    }
+                    set_escape( Result, '\b', "\\b" );
+                    set_escape( Result, '\f', "\\f" );
+                    set_escape( Result, '\n', "\\n" );
+                    set_escape( Result, '\r', "\\r" );
+                    set_escape( Result, '\t', "\\t" );
+                    set_escape( Result, '"', "\\\"" );
+                    set_escape( Result, '\\', "\\\\" );
+                    finish_escape_table( Result );
+                    return Result;
+                }();
+
+                return Table;
+            }
+
+            // HTML entity escapes
+            inline const escape_table& html_escape_table()
+            {
+                static const escape_table Table=[]
+                {
+                    escape_table Result{};
+                    set_escape( Result, '&', "&amp;" );
+                    set_escape( Result, '<', "&lt;" );
+                    set_escape( Result, '>', "&gt;" );
+                    set_escape( Result, '"', "&quot;" );
+                    set_escape( Result, '\'', "&#39;" );
+                    finish_escape_table( Result );
+                    return Result;
+                }();
+
+                return Table;
+            }
+
+            // URL percent-encoding
+            /*
+                All bytes except the unreserved characters of RFC 3986
+                (letters, digits, '-', '.', '_' and '~') are encoded.
+            */
+            inline const escape_table& url_escape_table()
+            {
+                static const escape_table Table=[]
+                {
+                    escape_table Result{};
+                    for( unsigned int Ch=0; Ch<256; ++Ch )
+                    {
+                        bool bUnreserved=
+                            ( Ch>='a' && Ch<='z' ) || ( Ch>='A' && Ch<='Z' ) || ( Ch>='0' && Ch<='9' ) ||
+                            Ch=='-' || Ch=='.' || Ch=='_' || Ch=='~';
+
+                        if( !bUnreserved )
+                        {
+                            const char Text[]={ '%', hex_digit(Ch>>4), hex_digit(Ch), 0 };
+                            set_escape( Result, static_cast<unsigned char>(Ch), Text );
+                        }
+                    }
+                    finish_escape_table( Result );
+                    return Result;
+                }();
+
+                return Table;
+            }
+
+//  escape finder  -----------------------------------------------------------//
+
+            // Find a run of characters, which have an escape sequence
+            /*
+                The input is scanned by vector compares, the clean run
+                preceding the match is not inspected character by character.
+            */
+            struct escape_finderF
+            {
+                explicit escape_finderF( const escape_table& Table ) : m_Table(&Table) {}
+
+                template< typename ForwardIteratorT >
+                std::span<std::remove_pointer_t<typename ForwardIteratorT::pointer>>
+                operator()( ForwardIteratorT Begin, ForwardIteratorT End ) const
+                {
+                    typedef std::span<std::remove_pointer_t<typename ForwardIteratorT::pointer>> result_type;
+
+                    const auto* First=std::to_address(Begin);
+                    const auto* Last=First+( End-Begin );
+
+                    const auto* MatchBegin=::string_algo::algorithm::detail::find_first_of_ranges( First, Last, m_Table->Set );
+                    if( MatchBegin==Last )
+                    {
+                        return result_type( End, End );
+                    }
+
+                    const auto* MatchEnd=MatchBegin+1;
+                    while( MatchEnd!=Last && m_Table->Set.contains( static_cast<unsigned char>(*MatchEnd) ) )
+                    {
+                        ++MatchEnd;
+                    }
+
+                    return result_type( Begin+( MatchBegin-First ), static_cast<std::size_t>( MatchEnd-MatchBegin ) );
+                }
+
+            private:
+                const escape_table* m_Table;
+            };
+
+//  escape formatter  --------------------------------------------------------//
+
+            // Write the escape sequences of a match
+            /*
+                A sized writer formatter. The replacement is written directly
+                to the output and its size can be computed up front.
+            */
+            struct escape_formatF
+            {
+                explicit escape_formatF( const escape_table& Table ) : m_Table(&Table) {}
+
+                template< typename MatchT >
+                std::size_t format_size( const MatchT& Match ) const
+                {
+                    std::size_t Size=0;
+                    for( auto Ch : Match )
+                    {
+                        Size+=(*m_Table)[ static_cast<unsigned char>(Ch) ].Size;
+                    }
+                    return Size;
+                }
+
+                template< typename MatchT, typename OutputIteratorT >
+                OutputIteratorT operator()( const MatchT& Match, OutputIteratorT Output ) const
+                {
+                    for( auto Ch : Match )
+                    {
+                        const escape_entry& Entry=(*m_Table)[ static_cast<unsigned char>(Ch) ];
+                        Output=std::copy( Entry.Text, Entry.Text+Entry.Size, Output );
+                    }
+                    return Output;
+                }
+
+            private:
+                const escape_table* m_Table;
+            };
+
+//  unescape decoders  -------------------------------------------------------//
+
+            // Parse Count hexadecimal digits, returns -1 if they are not all digits
+            template< typename CharT >
+            inline long parse_hex( const CharT* First, std::size_t Count )
+            {
+                long Value=0;
+                for( std::size_t Index=0; Index<Count; ++Index )
+                {
+                    int Digit=::string_algo::algorithm::detail::hex_value( First[Index] );
+                    if( Digit<0 ) return -1;
+                    Value=Value*16+Digit;
+                }
+                return Value;
+            }
+
+            // Decoders of escape sequences
+            /*
+                decode(First, Last, Output, Size) decodes the escape sequence starting
+                at First, which is the lead character. It writes at most 4 characters
+                to Output, stores their count to Size and returns the length of the
+                sequence. Zero is returned for a malformed sequence, which is kept
+                as it is.
+            */
+
+            // JSON string escapes, \uXXXX sequences are decoded to UTF-8
+            struct json_decoder
+            {
+                static const char lead='\\';
+
+                template< typename CharT >
+                static std::size_t decode( const CharT* First, const CharT* Last, CharT* Output, std::size_t& Size )
+                {
+                    if( Last-First<2 ) return 0;
+
+                    Size=1;
+                    switch( First[1] )
+                    {
+                    case '"': Output[0]='"'; return 2;
+                    case '\\': Output[0]='\\'; return 2;
+                    case '/': Output[0]='/'; return 2;
+                    case 'b': Output[0]='\b'; return 2;
+                    case 'f': Output[0]='\f'; return 2;
+                    case 'n': Output[0]='\n'; return 2;
+                    case 'r': Output[0]='\r'; return 2;
+                    case 't': Output[0]='\t'; return 2;
+                    case 'u': break;
+                    default: return 0;
+                    }
+
+                    if( Last-First<6 ) return 0;
+                    long Code=::string_algo::algorithm::detail::parse_hex( First+2, 4 );
+                    if( Code<0 || ( Code>=0xDC00 && Code<=0xDFFF ) ) return 0;
+
+                    if( Code<0xD800 || Code>0xDBFF )
+                    {
+                        Size=::string_algo::algorithm::detail::encode_utf8( static_cast<std::uint32_t>(Code), Output );
+                        return 6;
+                    }
+
+                    // Surrogate pair
+                    if( Last-First<12 || First[6]!='\\' || First[7]!='u' ) return 0;
+                    long Low=::string_algo::algorithm::detail::parse_hex( First+8, 4 );
+                    if( Low<0xDC00 || Low>0xDFFF ) return 0;
+
+                    Size=::string_algo::algorithm::detail::encode_utf8(
+                        static_cast<std::uint32_t>( 0x10000+( ( Code-0xD800 )<<10 )+( Low-0xDC00 ) ), Output );
+                    return 12;
+                }
+            };
+
+            // HTML character references
+            /*
+                The entities produced by the escape (amp, lt, gt, quot, apos)
+                and numeric references are decoded, the latter to UTF-8.
+            */
+            struct html_decoder
+            {
+                static const char lead='&';
+
+                template< typename CharT >
+                static std::size_t decode( const CharT* First, const CharT* Last, CharT* Output, std::size_t& Size )
+                {
+                    // Locate the terminating semicolon of a short reference
+                    const CharT* End=First+1;
+                    while( End!=Last && *End!=';' && End-First<10 ) ++End;
+                    if( End==Last || *End!=';' ) return 0;
+
+                    std::size_t Length=static_cast<std::size_t>( End-First )+1;
+                    const CharT* Name=First+1;
+                    std::size_t NameSize=Length-2;
+
+                    Size=1;
+                    if( equals( Name, NameSize, "amp" ) ) { Output[0]='&'; return Length; }
+                    if( equals( Name, NameSize, "lt" ) ) { Output[0]='<'; return Length; }
+                    if( equals( Name, NameSize, "gt" ) ) { Output[0]='>'; return Length; }
+                    if( equals( Name, NameSize, "quot" ) ) { Output[0]='"'; return Length; }
+                    if( equals( Name, NameSize, "apos" ) ) { Output[0]='\''; return Length; }
+
+                    if( NameSize<2 || Name[0]!='#' ) return 0;
+
+                    // Numeric reference
+                    long Code=0;
+                    if( Name[1]=='x' || Name[1]=='X' )
+                    {
+                        if( NameSize<3 || NameSize>8 ) return 0;
+                        Code=::string_algo::algorithm::detail::parse_hex( Name+2, NameSize-2 );
+                    }
+                    else
+                    {
+                        if( NameSize>8 ) return 0;
+                        for( std::size_t Index=1; Index<NameSize; ++Index )
+                        {
+                            if( Name[Index]<'0' || Name[Index]>'9' ) return 0;
+                            Code=Code*10+( Name[Index]-'0' );
+                        }
+                    }
+
+                    if( Code<=0 || Code>0x10FFFF || ( Code>=0xD800 && Code<=0xDFFF ) ) return 0;
+
+                    Size=::string_algo::algorithm::detail::encode_utf8( static_cast<std::uint32_t>(Code), Output );
+                    return Length;
+                }
+
+            private:
+                template< typename CharT >
+                static bool equals( const CharT* Name, std::size_t Size, const char* Literal )
+                {
+                    std::size_t Index=0;
+                    for( ; Index<Size && Literal[Index]!=0; ++Index )
+                    {
+                        if( Name[Index]!=Literal[Index] ) return false;
+                    }
+                    return Index==Size && Literal[Index]==0;
+                }
+            };
+
+            // URL percent-encoding
+            struct url_decoder
+            {
+                static const char lead='%';
+
+                template< typename CharT >
+                static std::size_t decode( const CharT* First, const CharT* Last, CharT* Output, std::size_t& Size )
+                {
+                    if( Last-First<3 ) return 0;
+
+                    long Value=::string_algo::algorithm::detail::parse_hex( First+1, 2 );
+                    if( Value<0 ) return 0;
+
+                    Output[0]=static_cast<CharT>( static_cast<unsigned char>(Value) );
+                    Size=1;
+                    return 3;
+                }
+            };
+
+//  unescape finder  ---------------------------------------------------------//
+
+            // Find a well formed escape sequence
+            /*
+                Lead characters are located by memchr. Malformed sequences
+                are skipped.
+            */
+            template< typename DecoderT >
+            struct unescape_finderF
+            {
+                template< typename ForwardIteratorT >
+                std::span<std::remove_pointer_t<typename ForwardIteratorT::pointer>>
+                operator()( ForwardIteratorT Begin, ForwardIteratorT End ) const
+                {
+                    typedef std::span<std::remove_pointer_t<typename ForwardIteratorT::pointer>> result_type;
+                    typedef std::remove_cv_t<typename result_type::element_type> char_type;
+
+                    const char_type* First=std::to_address(Begin);
+                    const char_type* Last=First+( End-Begin );
+
+                    for( const char_type* It=First;; ++It )
+                    {
+                        It=::string_algo::algorithm::detail::find_char( It, Last, static_cast<char_type>(DecoderT::lead) );
+                        if( It==Last )
+                        {
+                            return result_type( End, End );
+                        }
+
+                        char_type Buffer[4];
+                        std::size_t Size=0;
+                        std::size_t Length=DecoderT::decode( It, Last, Buffer, Size );
+                        if( Length!=0 )
+                        {
+                            return result_type( Begin+( It-First ), Length );
+                        }
+                    }
+                }
+            };
+
+//  unescape formatter  ------------------------------------------------------//
+
+            // Write the decoded character of an escape sequence
+            template< typename DecoderT >
+            struct unescape_formatF
+            {
+                template< typename MatchT >
+                std::size_t format_size( const MatchT& Match ) const
+                {
+                    typedef std::remove_cv_t<typename MatchT::element_type> char_type;
+
+                    char_type Buffer[4];
+                    std::size_t Size=0;
+                    DecoderT::decode( Match.data(), Match.data()+Match.size(), Buffer, Size );
+                    return Size;
+                }
+
+                template< typename MatchT, typename OutputIteratorT >
+                OutputIteratorT operator()( const MatchT& Match, OutputIteratorT Output ) const
+                {
+                    typedef std::remove_cv_t<typename MatchT::element_type> char_type;
+
+                    char_type Buffer[4];
+                    std::size_t Size=0;
+                    DecoderT::decode( Match.data(), Match.data()+Match.size(), Buffer, Size );
+                    return std::copy( Buffer, Buffer+Size, Output );
+                }
+            };
+
+        } // namespace detail
+    } // namespace algorithm
+} // namespace string_algo
+
+#endif  // STRING_ESCAPE_DETAIL_HPP
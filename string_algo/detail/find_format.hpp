@@ -3,6 +3,10 @@
 #define STRING_FIND_FORMAT_DETAIL_HPP
 
 
+#include <iterator>
+#include <ranges>
+
+#include "../as_literal.hpp"
 #include "./find_format_store.hpp"
 #include "./replace_storage.hpp"
 
@@ -26,14 +30,14 @@ namespace string_algo {
                 const FormatResultT& FormatResult )
             {       
                 typedef find_format_store<
-                    typename InputT::const_iterator,
+                    typename InputT::iterator,
                         FormatterT,
                         FormatResultT > store_type;
 
                 // Create store for the find result
                 store_type M( FindResult, FormatResult, Formatter );
 
-                if ( !M )
+                if ( M.empty() )
                 {
                     // Match not found - return original sequence
                     Output = std::copy( ::std::begin(Input), ::std::end(Input), Output );
@@ -88,27 +92,30 @@ namespace string_algo {
                 const FindResultT& FindResult,
                 const FormatResultT& FormatResult)
             {
+                auto lit_input=::string_algo::as_literal(Input);
+
                 typedef find_format_store<
-                    typename InputT::const_iterator,
+                    typename decltype(lit_input)::iterator,
                         FormatterT,
                         FormatResultT > store_type;
 
                 // Create store for the find result
                 store_type M( FindResult, FormatResult, Formatter );
 
-                if ( !M )
+                if ( M.empty() )
                 {
                     // Match not found - return original sequence
                     return InputT( Input );
                 }
 
                 InputT Output;
+                ::string_algo::algorithm::detail::reserve( Output, lit_input.size()-M.size()+std::ranges::size(M.format_result()) );
                 // Copy the beginning of the sequence
-                string_algo::algorithm::detail::insert( Output, ::std::end(Output), ::std::begin(Input), M.begin() );
+                string_algo::algorithm::detail::insert( Output, ::std::end(Output), lit_input.begin(), M.begin() );
                 // Copy formatted result
                 string_algo::algorithm::detail::insert( Output, ::std::end(Output), M.format_result() );
                 // Copy the rest of the sequence
-                string_algo::algorithm::detail::insert( Output, ::std::end(Output), M.end(), ::std::end(Input) );
+                string_algo::algorithm::detail::insert( Output, ::std::end(Output), M.end(), lit_input.end() );
 
                 return Output;
             }
@@ -122,7 +129,7 @@ namespace string_algo {
                 FormatterT Formatter,
                 const FindResultT& FindResult)
             {
-                if( ::string_algo::algorithm::detail::check_find_result(Input, FindResult) ) {
+                if( !FindResult.empty() ) {
                     return ::string_algo::algorithm::detail::find_format_copy_impl2(
                         Input,
                         Formatter,
@@ -147,21 +154,27 @@ namespace string_algo {
                 const FormatResultT& FormatResult)
             {
                 typedef find_format_store<
-                    typename InputT::iterator,
+                    typename FindResultT::iterator,
                         FormatterT,
                         FormatResultT > store_type;
 
                 // Create store for the find result
                 store_type M( FindResult, FormatResult, Formatter );
 
-                if ( !M )
+                if ( M.empty() )
                 {
                     // Search not found - return original sequence
                     return;
                 }
 
+                // Translate the match to the iterators of the input
+                typename InputT::iterator From=::std::begin(Input);
+                std::advance( From, M.data()-std::ranges::data(Input) );
+                typename InputT::iterator To=From;
+                std::advance( To, M.size() );
+
                 // Replace match
-                ::string_algo::algorithm::detail::replace( Input, M.begin(), M.end(), M.format_result() );
+                ::string_algo::algorithm::detail::replace( Input, From, To, M.format_result() );
             }
 
             template<
@@ -173,7 +186,7 @@ namespace string_algo {
                 FormatterT Formatter,
                 const FindResultT& FindResult)
             {
-                if( ::string_algo::algorithm::detail::check_find_result(Input, FindResult) ) {
+                if( !FindResult.empty() ) {
                     ::string_algo::algorithm::detail::find_format_impl2(
                         Input,
                         Formatter,
@@ -3,7 +3,18 @@
 #ifndef STRING_FIND_FORMAT_ALL_DETAIL_HPP
 #define STRING_FIND_FORMAT_ALL_DETAIL_HPP
 
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <ranges>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../as_literal.hpp"
 #include "./find_format_store.hpp"
+#include "./formatter.hpp"
 #include "./replace_storage.hpp"
 
 namespace string_algo {
@@ -12,6 +23,43 @@ namespace string_algo {
 
 // find_format_all_copy (iterator variant) implementation ---------------------------//
 
+            // find_format_all_copy with a writer formatter
+            /*
+                The formatter writes every replacement directly to the output.
+            */
+            template< 
+                typename OutputIteratorT,
+                typename CharT,
+                typename FinderT,
+                typename FormatterT,
+                typename FindResultT >
+            inline OutputIteratorT find_format_all_write(
+                OutputIteratorT Output,
+                std::span<CharT> Input,
+                FinderT Finder,
+                FormatterT Formatter,
+                FindResultT M )
+            {
+                typedef typename std::span<CharT>::iterator input_iterator_type;
+
+                input_iterator_type LastMatch=Input.begin();
+
+                while( !M.empty() )
+                {
+                    // Copy the beginning of the sequence
+                    Output = std::copy( LastMatch, M.begin(), Output );
+                    // Write the replacement
+                    Output = Formatter( static_cast<const FindResultT&>(M), Output );
+
+                    // Proceed to the next match
+                    LastMatch=M.end();
+                    M=Finder( LastMatch, Input.end() );
+                }
+
+                // Copy the rest of the sequence
+                return std::copy( LastMatch, Input.end(), Output );
+            }
+
            template< 
                 typename OutputIteratorT,
                 typename InputT,
@@ -27,7 +75,7 @@ namespace string_algo {
                 const FindResultT& FindResult,
                 const FormatResultT& FormatResult )
             {       
-                typedef typename InputT::const_iterator input_iterator_type; 
+                typedef typename InputT::iterator input_iterator_type; 
 
                 typedef find_format_store<
                         input_iterator_type, 
@@ -41,7 +89,7 @@ namespace string_algo {
                 input_iterator_type LastMatch=::std::begin(Input);
 
                 // Iterate through all matches
-                while( M )
+                while( !M.empty() )
                 {
                     // Copy the beginning of the sequence
                     Output = std::copy( LastMatch, M.begin(), Output );
@@ -72,7 +120,16 @@ namespace string_algo {
                 FormatterT Formatter,
                 const FindResultT& FindResult )
             {   
-                if( ::string_algo::algorithm::detail::check_find_result(Input, FindResult) ) {
+                if constexpr( is_writer_formatter<FormatterT, FindResultT, OutputIteratorT>::value )
+                {
+                    return ::string_algo::algorithm::detail::find_format_all_write(
+                        Output,
+                        std::span<typename InputT::element_type>( Input ),
+                        Finder,
+                        Formatter,
+                        FindResult );
+                }
+                else if( ::string_algo::algorithm::detail::check_find_result(Input, FindResult) ) {
                     return ::string_algo::algorithm::detail::find_format_all_copy_impl2( 
                         Output,
                         Input,
@@ -87,52 +144,151 @@ namespace string_algo {
 
  // find_format_all_copy implementation ----------------------------------------------//
 
-           template< 
-                typename InputT, 
+            // Append a range to a sequence, growing its capacity geometrically
+            template< typename SequenceT, typename ForwardIteratorT >
+            inline void append_grow(
+                SequenceT& Output,
+                ForwardIteratorT Begin,
+                ForwardIteratorT End )
+            {
+                if constexpr( requires { Output.capacity(); } )
+                {
+                    std::size_t Required=Output.size()+static_cast<std::size_t>( std::distance( Begin, End ) );
+                    if( Required>Output.capacity() )
+                    {
+                        Output.reserve( (std::max)( Required, Output.capacity()*2 ) );
+                    }
+                }
+
+                ::string_algo::algorithm::detail::insert( Output, ::std::end(Output), Begin, End );
+            }
+
+            // Append the result of find_format_all to a sequence
+            /*
+                Space for the result is reserved up front. The estimate is exact for
+                formatters with a fixed result size, the matches are counted in an
+                extra pass of the finder in this case. Otherwise the input size is
+                reserved and the capacity is doubled whenever it is exhausted.
+            */
+            template< 
+                typename SequenceT,
+                typename CharT,
                 typename FinderT,
                 typename FormatterT,
                 typename FindResultT,
                 typename FormatResultT >
-            inline InputT find_format_all_copy_impl2(
-                const InputT& Input,
+            inline void find_format_all_copy_to(
+                SequenceT& Output,
+                std::span<CharT> Input,
                 FinderT Finder,
                 FormatterT Formatter,
                 const FindResultT& FindResult,
                 const FormatResultT& FormatResult)
             {
-                typedef typename InputT::const_iterator input_iterator_type; 
+                typedef typename std::span<CharT>::iterator input_iterator_type; 
 
                 typedef find_format_store<
                         input_iterator_type, 
                         FormatterT,
                         FormatResultT > store_type;
 
+                // Estimate the size of the result
+                std::size_t Size=Input.size();
+                if constexpr( is_fixed_size_formatter<FormatterT>::value )
+                {
+                    std::size_t FormatSize=static_cast<std::size_t>( std::ranges::size(FormatResult) );
+                    for( std::span<CharT> Match(FindResult); !Match.empty(); Match=Finder( Match.end(), Input.end() ) )
+                    {
+                        Size=Size-Match.size()+FormatSize;
+                    }
+                }
+                ::string_algo::algorithm::detail::reserve( Output, Output.size()+Size );
+
                 // Create store for the find result
                 store_type M( FindResult, FormatResult, Formatter );
 
                 // Initialize last match
-                input_iterator_type LastMatch=::std::begin(Input);
-
-                // Output temporary
-                InputT Output;
+                input_iterator_type LastMatch=Input.begin();
 
                 // Iterate through all matches
-                while( M )
+                while( !M.empty() )
                 {
                     // Copy the beginning of the sequence
-                    string_algo::algorithm::detail::insert( Output, ::std::end(Output), LastMatch, M.begin() );
+                    ::string_algo::algorithm::detail::append_grow( Output, LastMatch, M.begin() );
                     // Copy formatted result
-                    string_algo::algorithm::detail::insert( Output, ::std::end(Output), M.format_result() );
+                    ::string_algo::algorithm::detail::append_grow( Output, ::std::begin(M.format_result()), ::std::end(M.format_result()) );
 
                     // Proceed to the next match
                     LastMatch=M.end();
-                    M=Finder( LastMatch, ::std::end(Input) );
+                    M=Finder( LastMatch, Input.end() );
                 }
 
                 // Copy the rest of the sequence
-                ::string_algo::algorithm::detail::insert( Output, ::std::end(Output), LastMatch, ::std::end(Input) );
+                ::string_algo::algorithm::detail::append_grow( Output, LastMatch, Input.end() );
+            }
 
-                return Output;
+            template< 
+                typename SequenceT,
+                typename CharT,
+                typename FinderT,
+                typename FormatterT,
+                typename FindResultT >
+            inline void find_format_all_copy_to(
+                SequenceT& Output,
+                std::span<CharT> Input,
+                FinderT Finder,
+                FormatterT Formatter,
+                const FindResultT& FindResult)
+            {
+                typedef std::remove_const_t<CharT> char_type;
+
+                if constexpr(
+                    is_contiguous_sequence<SequenceT>::value &&
+                    std::is_same_v< std::ranges::range_value_t<SequenceT>, char_type > &&
+                    is_writer_formatter<FormatterT, FindResultT, char_type*>::value &&
+                    is_sized_formatter<FormatterT, FindResultT>::value )
+                {
+                    // Compute the exact size of the result, then write it in place
+                    std::size_t Size=Input.size();
+                    for( std::span<CharT> Match(FindResult); !Match.empty(); Match=Finder( Match.end(), Input.end() ) )
+                    {
+                        Size=Size-Match.size()+static_cast<std::size_t>( Formatter.format_size( Match ) );
+                    }
+
+                    std::size_t Offset=Output.size();
+                    ::string_algo::algorithm::detail::resize_and_fill( Output, Offset+Size,
+                        [&]( char_type* Data )
+                        {
+                            ::string_algo::algorithm::detail::find_format_all_write(
+                                Data+Offset,
+                                Input,
+                                Finder,
+                                Formatter,
+                                FindResult );
+                        } );
+                }
+                else if constexpr( is_writer_formatter<FormatterT, FindResultT, std::back_insert_iterator<SequenceT>>::value )
+                {
+                    ::string_algo::algorithm::detail::reserve( Output, Output.size()+Input.size() );
+                    ::string_algo::algorithm::detail::find_format_all_write(
+                        std::back_inserter( Output ),
+                        Input,
+                        Finder,
+                        Formatter,
+                        FindResult );
+                }
+                else if( !std::span<CharT>(FindResult).empty() ) {
+                    ::string_algo::algorithm::detail::find_format_all_copy_to(
+                        Output,
+                        Input,
+                        Finder,
+                        Formatter,
+                        FindResult,
+                        Formatter(FindResult) );
+                } else {
+                    ::string_algo::algorithm::detail::reserve( Output, Output.size()+Input.size() );
+                    ::string_algo::algorithm::detail::insert( Output, ::std::end(Output), Input.begin(), Input.end() );
+                }
             }
 
             template< 
@@ -146,13 +302,15 @@ namespace string_algo {
                 FormatterT Formatter,
                 const FindResultT& FindResult)
             {
-                if( ::string_algo::algorithm::detail::check_find_result(Input, FindResult) ) {
-                    return ::string_algo::algorithm::detail::find_format_all_copy_impl2(
-                        Input,
+                if( !FindResult.empty() ) {
+                    InputT Output;
+                    ::string_algo::algorithm::detail::find_format_all_copy_to(
+                        Output,
+                        ::string_algo::as_literal(Input),
                         Finder,
                         Formatter,
-                        FindResult,
-                        Formatter(FindResult) );
+                        FindResult );
+                    return Output;
                 } else {
                     return Input;
                 }
@@ -235,6 +393,215 @@ namespace string_algo {
                 }
             }
 
+// find_format_all implementation for contiguous sequences --------------------//
+
+            // Copy a format result to the output
+            /*
+                The format result may overlap the output (e.g. the identity formatter
+                refers to the match itself), contiguous results are moved by memmove.
+                Returns the number of elements written.
+            */
+            template< typename CharT, typename FormatResultT >
+            inline std::size_t move_format_result(
+                CharT* Output,
+                const FormatResultT& FormatResult )
+            {
+                if constexpr(
+                    std::ranges::contiguous_range<const FormatResultT> &&
+                    std::is_same_v< std::remove_cv_t<std::ranges::range_value_t<const FormatResultT>>, CharT > &&
+                    std::is_trivially_copyable_v<CharT> )
+                {
+                    std::size_t Size=static_cast<std::size_t>( std::ranges::size(FormatResult) );
+                    if( Size!=0 )
+                    {
+                        std::memmove( Output, std::ranges::data(FormatResult), Size*sizeof(CharT) );
+                    }
+                    return Size;
+                }
+                else
+                {
+                    return static_cast<std::size_t>(
+                        std::copy( ::std::begin(FormatResult), ::std::end(FormatResult), Output )-Output );
+                }
+            }
+
+            // Move a part of the sequence
+            template< typename CharT >
+            inline void move_segment( CharT* Data, std::size_t To, std::size_t From, std::size_t Size )
+            {
+                if( To!=From && Size!=0 )
+                {
+                    std::memmove( Data+To, Data+From, Size*sizeof(CharT) );
+                }
+            }
+
+            // In-place replace of all matches in a contiguous sequence
+            /*
+                No replacement storage is used. The sequence is processed in a forward
+                pass, compacting it to the left, as long as the output does not overtake
+                the unprocessed input. This covers all replacements, which are not
+                longer than their matches.
+
+                When a replacement would overwrite unprocessed data and the formatter
+                replaces every match by the same result (see is_fixed_size_formatter),
+                the remaining matches are located first and the final size is computed.
+                The sequence is resized once and the rest of it is filled from the back.
+                If the remaining replacements both grow and shrink the sequence so that
+                neither direction is safe, the rest of the result is built in a temporary.
+
+                Results of other formatters are not known in advance, the rest of the
+                result is built in a temporary as they are produced. The formatter
+                is invoked once for every match.
+            */
+            template<
+                typename InputT,
+                typename FinderT,
+                typename FormatterT,
+                typename FindResultT,
+                typename FormatResultT >
+            inline void find_format_all_contiguous_impl(
+                InputT& Input,
+                FinderT Finder,
+                FormatterT Formatter,
+                FindResultT FindResult,
+                FormatResultT FormatResult)
+            {
+                typedef std::remove_pointer_t<typename InputT::pointer> char_type;
+                typedef std::span<char_type> range_type;
+                typedef typename range_type::iterator input_iterator_type;
+                typedef find_format_store<
+                        input_iterator_type,
+                        FormatterT,
+                        FormatResultT > store_type;
+
+                range_type lit_input( std::ranges::data(Input), std::ranges::size(Input) );
+                char_type* Data=lit_input.data();
+                std::size_t Size=lit_input.size();
+
+                // Create store for the find result
+                store_type M( FindResult, FormatResult, Formatter );
+
+                // Forward pass, compact the sequence to the left
+                std::size_t Write=0;
+                std::size_t Read=0;
+                while( !M.empty() )
+                {
+                    std::size_t MatchBegin=static_cast<std::size_t>( M.data()-Data );
+                    std::size_t MatchEnd=MatchBegin+M.size();
+                    std::size_t FormatSize=static_cast<std::size_t>( std::ranges::size(M.format_result()) );
+
+                    if( Write+( MatchBegin-Read )+FormatSize>MatchEnd )
+                    {
+                        // The replacement would overwrite unprocessed data
+                        break;
+                    }
+
+                    ::string_algo::algorithm::detail::move_segment( Data, Write, Read, MatchBegin-Read );
+                    Write+=MatchBegin-Read;
+                    Write+=::string_algo::algorithm::detail::move_format_result( Data+Write, M.format_result() );
+
+                    Read=MatchEnd;
+                    M=Finder( lit_input.begin()+Read, lit_input.end() );
+                }
+
+                if( M.empty() )
+                {
+                    // Move the rest of the sequence and truncate it
+                    ::string_algo::algorithm::detail::move_segment( Data, Write, Read, Size-Read );
+                    Input.resize( Write+( Size-Read ) );
+                    return;
+                }
+
+                if constexpr( !is_fixed_size_formatter<FormatterT>::value )
+                {
+                    // The replacements are not known in advance, build the rest
+                    // in a temporary while the remaining matches are formatted
+                    InputT Rest;
+                    ::string_algo::algorithm::detail::reserve( Rest, Size-Read );
+
+                    std::size_t Next=Read;
+                    while( !M.empty() )
+                    {
+                        std::size_t MatchBegin=static_cast<std::size_t>( M.data()-Data );
+                        ::string_algo::algorithm::detail::insert( Rest, ::std::end(Rest), Data+Next, Data+MatchBegin );
+                        ::string_algo::algorithm::detail::insert( Rest, ::std::end(Rest), M.format_result() );
+
+                        Next=MatchBegin+M.size();
+                        M=Finder( lit_input.begin()+Next, lit_input.end() );
+                    }
+                    ::string_algo::algorithm::detail::insert( Rest, ::std::end(Rest), Data+Next, Data+Size );
+
+                    Input.resize( Write );
+                    ::string_algo::algorithm::detail::insert( Input, ::std::end(Input), ::std::begin(Rest), ::std::end(Rest) );
+                }
+                else
+                {
+                    // Every match is replaced by the same replacement
+                    const FormatResultT Replacement=M.format_result();
+                    std::size_t FormatSize=static_cast<std::size_t>( std::ranges::size(Replacement) );
+
+                    // Locate the remaining matches and compute the final size.
+                    // Shift is the displacement of the input following the last match.
+                    std::vector< std::pair<std::size_t, std::size_t> > Matches;
+                    std::ptrdiff_t Shift=static_cast<std::ptrdiff_t>(Write)-static_cast<std::ptrdiff_t>(Read);
+                    bool bBackward=true;
+                    while( !M.empty() )
+                    {
+                        std::size_t MatchBegin=static_cast<std::size_t>( M.data()-Data );
+                        Matches.emplace_back( MatchBegin, MatchBegin+M.size() );
+
+                        Shift+=static_cast<std::ptrdiff_t>(FormatSize)-static_cast<std::ptrdiff_t>( M.size() );
+                        if( Shift<0 ) bBackward=false;
+
+                        M=Finder( lit_input.begin()+Matches.back().second, lit_input.end() );
+                    }
+
+                    std::size_t FinalSize=static_cast<std::size_t>( static_cast<std::ptrdiff_t>(Size)+Shift );
+
+                    if( !bBackward )
+                    {
+                        // Mixed growth, build the rest in a temporary
+                        InputT Rest;
+                        ::string_algo::algorithm::detail::reserve( Rest, FinalSize-Write );
+
+                        std::size_t Next=Read;
+                        for( const std::pair<std::size_t, std::size_t>& Match : Matches )
+                        {
+                            ::string_algo::algorithm::detail::insert( Rest, ::std::end(Rest), Data+Next, Data+Match.first );
+                            ::string_algo::algorithm::detail::insert( Rest, ::std::end(Rest), Replacement );
+                            Next=Match.second;
+                        }
+                        ::string_algo::algorithm::detail::insert( Rest, ::std::end(Rest), Data+Next, Data+Size );
+
+                        Input.resize( Write );
+                        ::string_algo::algorithm::detail::insert( Input, ::std::end(Input), ::std::begin(Rest), ::std::end(Rest) );
+                        return;
+                    }
+
+                    // Move the segment preceding the first remaining match left
+                    ::string_algo::algorithm::detail::move_segment( Data, Write, Read, Matches.front().first-Read );
+
+                    Input.resize( FinalSize );
+                    Data=std::ranges::data(Input);
+
+                    // Fill the sequence from the back
+                    std::size_t Output=FinalSize;
+                    std::size_t Next=Size;
+                    for( std::size_t Index=Matches.size(); Index-->0; )
+                    {
+                        const std::pair<std::size_t, std::size_t>& Match=Matches[Index];
+
+                        Output-=Next-Match.second;
+                        ::string_algo::algorithm::detail::move_segment( Data, Output, Match.second, Next-Match.second );
+
+                        Output-=FormatSize;
+                        ::string_algo::algorithm::detail::move_format_result( Data+Output, Replacement );
+
+                        Next=Match.first;
+                    }
+                }
+            }
+
             template<
                 typename InputT,
                 typename FinderT,
@@ -248,12 +615,36 @@ namespace string_algo {
             {
                
                 if( ::string_algo::algorithm::detail::check_find_result(Input, FindResult) ) {
-                    ::string_algo::algorithm::detail::find_format_all_impl2(
-                     Input,
-                        Finder,
-                        Formatter,
-                        FindResult,
-                        Formatter(FindResult) );
+                    if constexpr( is_writer_formatter<FormatterT, FindResultT, std::back_insert_iterator<InputT>>::value )
+                    {
+                        // Replacement sizes are not known in advance, build the result in one sweep
+                        InputT Output;
+                        ::string_algo::algorithm::detail::find_format_all_copy_to(
+                            Output,
+                            ::string_algo::as_literal(Input),
+                            Finder,
+                            Formatter,
+                            FindResult );
+                        Input=std::move( Output );
+                    }
+                    else if constexpr( is_contiguous_sequence<InputT>::value )
+                    {
+                        ::string_algo::algorithm::detail::find_format_all_contiguous_impl(
+                            Input,
+                            Finder,
+                            Formatter,
+                            FindResult,
+                            Formatter(FindResult) );
+                    }
+                    else
+                    {
+                        ::string_algo::algorithm::detail::find_format_all_impl2(
+                         Input,
+                            Finder,
+                            Formatter,
+                            FindResult,
+                            Formatter(FindResult) );
+                    }
                 }
             }
 
@@ -71,6 +71,12 @@ namespace string_algo {
 					return result_type(End, End);
 				}
 
+				// Length of every match
+				std::size_t match_size() const
+				{
+					return m_Search.size();
+				}
+
 			private:
 
 				std::span<std::remove_pointer_t<typename search_iterator_type::pointer>> m_Search;
@@ -260,17 +266,20 @@ namespace string_algo {
 						m_Search.begin(), m_Search.end(), m_Comp);
 
 					result_type M(Begin, Begin);
+					ForwardIteratorT Next = Begin;
 
 					for (unsigned int n = 0; n <= N; ++n)
 					{
 						// find next match
-						M = first_finder(::std::end(M), End);
+						M = first_finder(Next, End);
 
-						if (!M.empty())
+						if (M.empty())
 						{
 							// Subsequence not found, return
 							return M;
 						}
+
+						Next = Begin + (M.data() + M.size() - std::to_address(Begin));
 					}
 
 					return M;
@@ -294,17 +303,20 @@ namespace string_algo {
 						m_Search.begin(), m_Search.end(), m_Comp);
 
 					result_type M(End, End);
+					ForwardIteratorT Last = End;
 
 					for (unsigned int n = 1; n <= N; ++n)
 					{
 						// find next match
-						M = last_finder(Begin, ::std::begin(M));
+						M = last_finder(Begin, Last);
 
-						if (!M.empty())
+						if (M.empty())
 						{
 							// Subsequence not found, return
 							return M;
 						}
+
+						Last = Begin + (M.data() - std::to_address(Begin));
 					}
 
 					return M;
@@ -473,7 +485,8 @@ namespace string_algo {
 						std::span<std::remove_pointer_t<typename  ForwardIteratorT::pointer>> Res =
 							::string_algo::algorithm::detail::find_tail_impl(Begin, End, -m_N);
 
-						return  std::span(Begin, Res.begin());
+						return std::span<std::remove_pointer_t<typename  ForwardIteratorT::pointer>>(
+							Begin, std::distance(Begin, End) - Res.size());
 					}
 				}
 
@@ -511,7 +524,8 @@ namespace string_algo {
 						std::span<std::remove_pointer_t<typename  ForwardIteratorT::pointer>> Res =
 							::string_algo::algorithm::detail::find_head_impl(Begin, End, -m_N);
 
-						return std::span(Res.end(), End);
+						return std::span<std::remove_pointer_t<typename  ForwardIteratorT::pointer>>(
+							std::next(Begin, Res.size()), End);
 					}
 				}
 
@@ -602,7 +616,7 @@ namespace string_algo {
 
 				// Operation
 				template< typename ForwardIterator2T >
-				std::span<typename ForwardIterator2T::value_type>
+				result_type
 					operator()(
 						ForwardIterator2T,
 						ForwardIterator2T) const
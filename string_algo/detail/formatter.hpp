@@ -4,6 +4,10 @@
 #define STRING_FORMATTER_DETAIL_HPP
 
 
+#include <concepts>
+#include <cstddef>
+#include <type_traits>
+
 #include "./util.hpp"
 
 //  generic replace functors -----------------------------------------------//
@@ -73,6 +77,44 @@ namespace string_algo {
                 }
             };
 
+//  fixed size formatter trait ---------------------------------------------//
+
+            // Formatters, which produce the same result for every match
+            template< typename FormatterT >
+            struct is_fixed_size_formatter : std::false_type {};
+
+            template< typename RangeT >
+            struct is_fixed_size_formatter< const_formatF<RangeT> > : std::true_type {};
+
+            template< typename CharT >
+            struct is_fixed_size_formatter< empty_formatF<CharT> > : std::true_type {};
+
+//  writer formatter trait -------------------------------------------------//
+
+            // Formatters, which write the replacement to an output iterator
+            /*
+                A writer formatter is invoked as Formatter(Match, Output) and
+                returns the output iterator past the written replacement.
+                No format result is materialized. The formatter may keep state,
+                it is invoked through a non-const copy.
+            */
+            template< typename FormatterT, typename MatchT, typename OutputIteratorT >
+            struct is_writer_formatter :
+                std::bool_constant< std::is_invocable_r_v<OutputIteratorT, FormatterT&, const MatchT&, OutputIteratorT> > {};
+
+            // Writer formatters, which also report the size of a replacement
+            /*
+                Formatter.format_size(Match) returns the number of elements
+                written for the match. The size of the whole result can be
+                computed up front then.
+            */
+            template< typename FormatterT, typename MatchT >
+            struct is_sized_formatter :
+                std::bool_constant< requires( const FormatterT& Formatter, const MatchT& Match )
+                {
+                    { Formatter.format_size( Match ) } -> std::convertible_to<std::size_t>;
+                } > {};
+
 //  dissect format functor ----------------------------------------------------//
 
             // dissect format functor
@@ -0,0 +1,290 @@
+
+#ifndef STRING_IHASH_DETAIL_HPP
+#define STRING_IHASH_DETAIL_HPP
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "case_conv.hpp"
+#include "ctype_table.hpp"
+#include "simd.hpp"
+
+namespace string_algo {
+    namespace algorithm {
+        namespace detail {
+
+//  case insensitive folding  ----------------------------------------------//
+
+            // Fold a block of 16 narrow characters to upper case
+            /*
+                The folding agrees with the upper case table of the locale, which is
+                used by the case insensitive comparison predicates.
+            */
+            template< typename CharT >
+            inline void ifold_block( const CharT* First, unsigned char* Output, const ctype_table& Table )
+            {
+#if defined(STRING_ALGO_SSE2)
+                if( Table.ascii_case() )
+                {
+                    __m128i Block=_mm_loadu_si128( reinterpret_cast<const __m128i*>(First) );
+                    _mm_storeu_si128( reinterpret_cast<__m128i*>(Output), ascii_case_block<true>( Block ) );
+                    if( Table.high_case_identity() || _mm_movemask_epi8( Block )==0 ) return;
+                }
+#endif
+                const unsigned char* Upper=Table.upper_table();
+                for( unsigned int Index=0; Index<16; ++Index )
+                {
+                    Output[Index]=Upper[static_cast<unsigned char>( First[Index] )];
+                }
+            }
+
+            // Load the last Size<16 bytes of a string into a block
+            /*
+                The bytes are gathered by overlapping loads, which do not read past
+                the end. The layout depends only on the size, so the blocks of two
+                strings of the same size are equal exactly if the strings are equal.
+            */
+            template< typename CharT >
+            inline void load_partial_block( const CharT* First, std::size_t Size, unsigned char* Block )
+            {
+                std::uint64_t Low=0;
+                std::uint64_t High=0;
+                if( Size>=8 )
+                {
+                    std::memcpy( &Low, First, 8 );
+                    std::memcpy( &High, First+Size-8, 8 );
+                }
+                else if( Size>=4 )
+                {
+                    std::uint32_t Low32, High32;
+                    std::memcpy( &Low32, First, 4 );
+                    std::memcpy( &High32, First+Size-4, 4 );
+                    Low=Low32;
+                    High=High32;
+                }
+                else if( Size>0 )
+                {
+                    Low=static_cast<std::uint64_t>( static_cast<unsigned char>( First[0] ) ) |
+                        static_cast<std::uint64_t>( static_cast<unsigned char>( First[Size/2] ) )<<8 |
+                        static_cast<std::uint64_t>( static_cast<unsigned char>( First[Size-1] ) )<<16;
+                }
+                std::memcpy( Block, &Low, 8 );
+                std::memcpy( Block+8, &High, 8 );
+            }
+
+            // Check if two narrow strings of the same size are equal ignoring case
+            /*
+                The last block overlaps the previous one, or is gathered by
+                load_partial_block for short strings.
+            */
+            template< typename Char1T, typename Char2T >
+            inline bool iequal_bytes(
+                const Char1T* First1,
+                const Char2T* First2,
+                std::size_t Size,
+                const ctype_table& Table )
+            {
+                unsigned char Folded1[16];
+                unsigned char Folded2[16];
+
+                if( Size<16 )
+                {
+                    unsigned char Block1[16];
+                    unsigned char Block2[16];
+                    ::string_algo::algorithm::detail::load_partial_block( First1, Size, Block1 );
+                    ::string_algo::algorithm::detail::load_partial_block( First2, Size, Block2 );
+                    ::string_algo::algorithm::detail::ifold_block( Block1, Folded1, Table );
+                    ::string_algo::algorithm::detail::ifold_block( Block2, Folded2, Table );
+                    return std::memcmp( Folded1, Folded2, 16 )==0;
+                }
+
+                for( std::size_t Pos=0; ; Pos+=16 )
+                {
+                    if( Size-Pos<16 ) Pos=Size-16;
+
+                    ::string_algo::algorithm::detail::ifold_block( First1+Pos, Folded1, Table );
+                    ::string_algo::algorithm::detail::ifold_block( First2+Pos, Folded2, Table );
+                    if( std::memcmp( Folded1, Folded2, 16 )!=0 ) return false;
+                    if( Pos+16==Size ) return true;
+                }
+            }
+
+            // Find the first position, where two narrow strings differ ignoring case
+            /*
+                Returns Size, if the strings are equal. Blocks are folded and compared
+                16 bytes at a time in locales, which convert ASCII like the classic locale.
+            */
+            template< typename Char1T, typename Char2T >
+            inline std::size_t imismatch_bytes(
+                const Char1T* First1,
+                const Char2T* First2,
+                std::size_t Size,
+                const ctype_table& Table )
+            {
+                std::size_t Pos=0;
+                const unsigned char* Upper=Table.upper_table();
+
+#if defined(STRING_ALGO_SSE2)
+                if( Table.ascii_case() )
+                {
+                    for( ; Size-Pos>=16; Pos+=16 )
+                    {
+                        __m128i Block1=_mm_loadu_si128( reinterpret_cast<const __m128i*>(First1+Pos) );
+                        __m128i Block2=_mm_loadu_si128( reinterpret_cast<const __m128i*>(First2+Pos) );
+                        unsigned int Mask=~static_cast<unsigned int>( _mm_movemask_epi8(
+                            _mm_cmpeq_epi8( ascii_case_block<true>( Block1 ), ascii_case_block<true>( Block2 ) ) ) ) & 0xFFFF;
+
+                        if( Mask==0 ) continue;
+                        if( Table.high_case_identity() ) return Pos+std::countr_zero( Mask );
+
+                        // Bytes above 0x7F may still be equal by the table of the locale
+                        for( std::size_t Index=Pos+std::countr_zero( Mask ); Index<Pos+16; ++Index )
+                        {
+                            if( Upper[static_cast<unsigned char>( First1[Index] )]!=Upper[static_cast<unsigned char>( First2[Index] )] )
+                            {
+                                return Index;
+                            }
+                        }
+                    }
+                }
+#endif
+
+                for( ; Pos!=Size; ++Pos )
+                {
+                    if( Upper[static_cast<unsigned char>( First1[Pos] )]!=Upper[static_cast<unsigned char>( First2[Pos] )] )
+                    {
+                        return Pos;
+                    }
+                }
+                return Size;
+            }
+
+            // Find the first position, where two strings differ ignoring case
+            template< typename Char1T, typename Char2T >
+            inline std::size_t imismatch(
+                const Char1T* First1,
+                const Char2T* First2,
+                std::size_t Size,
+                const ctype_table& Table )
+            {
+                if constexpr( is_byte_char<Char1T>::value && is_byte_char<Char2T>::value )
+                {
+                    return ::string_algo::algorithm::detail::imismatch_bytes( First1, First2, Size, Table );
+                }
+                else
+                {
+                    for( std::size_t Pos=0; Pos!=Size; ++Pos )
+                    {
+                        if( Table.toupper( First1[Pos] )!=Table.toupper( First2[Pos] ) ) return Pos;
+                    }
+                    return Size;
+                }
+            }
+
+            // Three-way case insensitive comparison of two strings
+            /*
+                Only the first mismatch is ordered, by the upper case characters
+                like is_iless. A proper prefix orders before the longer string.
+            */
+            template< typename Char1T, typename Char2T >
+            inline int icompare3(
+                const Char1T* First1,
+                std::size_t Size1,
+                const Char2T* First2,
+                std::size_t Size2,
+                const ctype_table& Table )
+            {
+                std::size_t Size=Size1<Size2 ? Size1 : Size2;
+                std::size_t Pos=::string_algo::algorithm::detail::imismatch( First1, First2, Size, Table );
+                if( Pos==Size )
+                {
+                    return Size1<Size2 ? -1 : Size1>Size2 ? 1 : 0;
+                }
+
+                return Table.toupper( First1[Pos] )<Table.toupper( First2[Pos] ) ? -1 : 1;
+            }
+
+//  case insensitive hash  -------------------------------------------------//
+
+            // Hash state update with a word of input
+            inline std::uint64_t ihash_mix( std::uint64_t State, std::uint64_t Word )
+            {
+                State=( State ^ Word )*0x9E3779B97F4A7C15ull;
+                return State ^ ( State>>32 );
+            }
+
+            // Final avalanche of the hash state
+            inline std::uint64_t ihash_finish( std::uint64_t State )
+            {
+                State^=State>>33;
+                State*=0xFF51AFD7ED558CCDull;
+                State^=State>>33;
+                State*=0xC4CEB9FE1A85EC53ull;
+                return State ^ ( State>>33 );
+            }
+
+            // Case insensitive hash of a string
+            /*
+                The characters are folded to upper case 16 bytes at a time and hashed
+                in two lanes of 8 bytes, no folded copy of the string is made.
+                A partial last block overlaps the previous one, or is gathered by
+                load_partial_block for short strings. The size is hashed at the end.
+            */
+            template< typename CharT >
+            inline std::uint64_t ihash_range( const CharT* First, std::size_t Size, const ctype_table& Table )
+            {
+                std::uint64_t Lane1=0x243F6A8885A308D3ull;
+                std::uint64_t Lane2=0x13198A2E03707344ull;
+
+                if constexpr( is_byte_char<CharT>::value )
+                {
+                    unsigned char Folded[16];
+                    std::uint64_t Words[2];
+
+                    std::size_t Pos=0;
+                    for( ; Size-Pos>=16; Pos+=16 )
+                    {
+                        ::string_algo::algorithm::detail::ifold_block( First+Pos, Folded, Table );
+                        std::memcpy( Words, Folded, 16 );
+                        Lane1=::string_algo::algorithm::detail::ihash_mix( Lane1, Words[0] );
+                        Lane2=::string_algo::algorithm::detail::ihash_mix( Lane2, Words[1] );
+                    }
+
+                    if( Pos!=Size )
+                    {
+                        if( Size>=16 )
+                        {
+                            ::string_algo::algorithm::detail::ifold_block( First+Size-16, Folded, Table );
+                        }
+                        else
+                        {
+                            unsigned char Block[16];
+                            ::string_algo::algorithm::detail::load_partial_block( First, Size, Block );
+                            ::string_algo::algorithm::detail::ifold_block( Block, Folded, Table );
+                        }
+                        std::memcpy( Words, Folded, 16 );
+                        Lane1=::string_algo::algorithm::detail::ihash_mix( Lane1, Words[0] );
+                        Lane2=::string_algo::algorithm::detail::ihash_mix( Lane2, Words[1] );
+                    }
+                }
+                else
+                {
+                    for( std::size_t Pos=0; Pos!=Size; ++Pos )
+                    {
+                        Lane1=::string_algo::algorithm::detail::ihash_mix(
+                            Lane1, static_cast<std::uint64_t>( Table.toupper( First[Pos] ) ) );
+                    }
+                }
+
+                return ::string_algo::algorithm::detail::ihash_finish(
+                    Lane1 ^ std::rotl( Lane2, 32 ) ^ ( static_cast<std::uint64_t>(Size)*0x9E3779B97F4A7C15ull ) );
+            }
+
+        } // namespace detail
+    } // namespace algorithm
+} // namespace string_algo
+
+#endif  // STRING_IHASH_DETAIL_HPP
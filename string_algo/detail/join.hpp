@@ -0,0 +1,343 @@
+
+#ifndef STRING_JOIN_DETAIL_HPP
+#define STRING_JOIN_DETAIL_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <numeric>
+#include <ranges>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "parallel.hpp"
+#include "sequence.hpp"
+
+namespace string_algo {
+    namespace algorithm {
+        namespace detail {
+
+//  join helpers  ---------------------------------------------------------//
+
+            // Segment selection predicate of the unconditional join
+            struct join_allF
+            {
+                template< typename T >
+                bool operator()( const T& ) const { return true; }
+            };
+
+            // Size of a segment
+            template< typename RangeT >
+            inline std::size_t segment_size( const RangeT& Segment )
+            {
+                if constexpr( std::ranges::sized_range<const RangeT> )
+                {
+                    return static_cast<std::size_t>( std::ranges::size(Segment) );
+                }
+                else
+                {
+                    return static_cast<std::size_t>( std::distance( ::std::begin(Segment), ::std::end(Segment) ) );
+                }
+            }
+
+            // Copy a segment to the output
+            /*
+                Contiguous segments of the same element type are copied by memcpy.
+            */
+            template< typename CharT, typename RangeT >
+            inline CharT* copy_segment( CharT* Output, const RangeT& Segment )
+            {
+                if constexpr(
+                    std::ranges::contiguous_range<const RangeT> &&
+                    std::is_same_v< std::remove_cv_t<std::ranges::range_value_t<const RangeT>>, CharT > &&
+                    std::is_trivially_copyable_v<CharT> )
+                {
+                    std::size_t Size=static_cast<std::size_t>( std::ranges::size(Segment) );
+                    if( Size!=0 )
+                    {
+                        std::memcpy( Output, std::ranges::data(Segment), Size*sizeof(CharT) );
+                    }
+                    return Output+Size;
+                }
+                else
+                {
+                    return std::copy( ::std::begin(Segment), ::std::end(Segment), Output );
+                }
+            }
+
+//  join implementation  ----------------------------------------------------//
+
+            // Compute the size of a join result
+            /*
+                Returns the total size of the selected segments and separators.
+                Count is set to the number of selected segments, Single points
+                to the last one of them.
+            */
+            template< typename SequenceSequenceT, typename SeparatorT, typename PredicateT >
+            inline std::size_t join_size(
+                const SequenceSequenceT& Input,
+                const SeparatorT& Separator,
+                PredicateT& Pred,
+                std::size_t& Count,
+                const typename SequenceSequenceT::value_type*& Single )
+            {
+                typedef typename SequenceSequenceT::value_type segment_type;
+
+                std::size_t Size=0;
+                Count=0;
+                Single=nullptr;
+                for( const segment_type& Segment : Input )
+                {
+                    if( Pred(Segment) )
+                    {
+                        Size+=::string_algo::algorithm::detail::segment_size(Segment);
+                        ++Count;
+                        Single=&Segment;
+                    }
+                }
+
+                if( Count>1 )
+                {
+                    Size+=( Count-1 )*::string_algo::algorithm::detail::segment_size(Separator);
+                }
+
+                return Size;
+            }
+
+            // Copy the selected segments and separators to the output
+            /*
+                Output may be a pointer or any output iterator.
+                Returns the end of the written sequence.
+            */
+            template< typename OutputIteratorT, typename SequenceSequenceT, typename SeparatorT, typename PredicateT >
+            inline OutputIteratorT join_write(
+                OutputIteratorT Output,
+                const SequenceSequenceT& Input,
+                const SeparatorT& Separator,
+                PredicateT& Pred )
+            {
+                typedef typename SequenceSequenceT::value_type segment_type;
+
+                bool bFirst=true;
+                for( const segment_type& Segment : Input )
+                {
+                    if( !Pred(Segment) ) continue;
+
+                    if constexpr( std::is_pointer_v<OutputIteratorT> )
+                    {
+                        if( !bFirst )
+                        {
+                            Output=::string_algo::algorithm::detail::copy_segment( Output, Separator );
+                        }
+                        Output=::string_algo::algorithm::detail::copy_segment( Output, Segment );
+                    }
+                    else
+                    {
+                        if( !bFirst )
+                        {
+                            Output=std::copy( ::std::begin(Separator), ::std::end(Separator), Output );
+                        }
+                        Output=std::copy( ::std::begin(Segment), ::std::end(Segment), Output );
+                    }
+                    bFirst=false;
+                }
+
+                return Output;
+            }
+
+            // Append the join result to a sequence
+            /*
+                Contiguous sequences are resized once and filled in place,
+                other ones are reserved when possible and filled by insertion.
+            */
+            template< typename SequenceT, typename SequenceSequenceT, typename SeparatorT, typename PredicateT >
+            inline void join_append(
+                SequenceT& Output,
+                std::size_t Size,
+                const SequenceSequenceT& Input,
+                const SeparatorT& Separator,
+                PredicateT& Pred )
+            {
+                typedef typename SequenceSequenceT::value_type segment_type;
+
+                if constexpr( is_contiguous_sequence<SequenceT>::value )
+                {
+                    std::size_t Offset=static_cast<std::size_t>( std::ranges::size(Output) );
+                    ::string_algo::algorithm::detail::resize_and_fill( Output, Offset+Size,
+                        [&]( auto* Data )
+                        {
+                            ::string_algo::algorithm::detail::join_write( Data+Offset, Input, Separator, Pred );
+                        } );
+                }
+                else
+                {
+                    if constexpr( requires { Output.size(); } )
+                    {
+                        ::string_algo::algorithm::detail::reserve( Output, Output.size()+Size );
+                    }
+
+                    bool bFirst=true;
+                    for( const segment_type& Segment : Input )
+                    {
+                        if( !Pred(Segment) ) continue;
+
+                        if( !bFirst )
+                        {
+                            ::string_algo::algorithm::detail::insert( Output, ::std::end(Output), Separator );
+                        }
+                        ::string_algo::algorithm::detail::insert( Output, ::std::end(Output), Segment );
+                        bFirst=false;
+                    }
+                }
+            }
+
+            // Two-pass join
+            /*
+                The first pass sums the sizes of the selected segments and separators,
+                the second one allocates the result once and copies the pieces.
+                The predicate is invoked once for every segment, its decisions
+                are recorded by the first pass and replayed by the second one.
+            */
+            template< typename ResultT, typename SequenceSequenceT, typename SeparatorT, typename PredicateT >
+            inline ResultT join_impl(
+                const SequenceSequenceT& Input,
+                const SeparatorT& Separator,
+                PredicateT Pred )
+            {
+                typedef typename SequenceSequenceT::value_type segment_type;
+                constexpr bool bSelectAll=std::is_same_v<PredicateT, join_allF>;
+
+                std::vector<bool> Selected;
+                if constexpr( !bSelectAll && std::ranges::sized_range<const SequenceSequenceT> )
+                {
+                    Selected.reserve( static_cast<std::size_t>( std::ranges::size(Input) ) );
+                }
+
+                auto Record=[&]( const segment_type& Segment )
+                {
+                    if constexpr( bSelectAll ) return true;
+                    else
+                    {
+                        bool bSelected=static_cast<bool>( Pred(Segment) );
+                        Selected.push_back( bSelected );
+                        return bSelected;
+                    }
+                };
+
+                std::size_t Index=0;
+                auto Replay=[&]( const segment_type& )
+                {
+                    if constexpr( bSelectAll ) return true;
+                    else return static_cast<bool>( Selected[Index++] );
+                };
+
+                // Compute the exact size of the result
+                std::size_t Count=0;
+                const segment_type* Single=nullptr;
+                std::size_t Size=::string_algo::algorithm::detail::join_size( Input, Separator, Record, Count, Single );
+
+                if( Count==0 )
+                {
+                    return ResultT();
+                }
+
+                if constexpr( std::is_constructible_v<ResultT, const segment_type&> )
+                {
+                    if( Count==1 )
+                    {
+                        // Single segment, no separator to add
+                        return ResultT( *Single );
+                    }
+                }
+
+                ResultT Result;
+                ::string_algo::algorithm::detail::join_append( Result, Size, Input, Separator, Replay );
+                return Result;
+            }
+
+//  parallel join  --------------------------------------------------------//
+
+            // Minimal number of segments processed by one parallel_join worker
+            const std::size_t parallel_join_min_segments=std::size_t(1)<<12;
+
+            // Join performed by several threads
+            /*
+                Segments are divided into contiguous index chunks. The first parallel
+                pass computes the output size of every chunk, an exclusive prefix sum
+                of these sizes gives the output offset of each chunk. The result
+                is allocated once and the second parallel pass copies every chunk
+                to its final position.
+            */
+            template< typename ResultT, typename SequenceSequenceT, typename SeparatorT >
+            inline ResultT parallel_join_impl(
+                const SequenceSequenceT& Input,
+                const SeparatorT& Separator,
+                unsigned int Concurrency )
+            {
+                static_assert( is_contiguous_sequence<ResultT>::value,
+                    "parallel_join requires a contiguous result sequence" );
+
+                std::size_t Segments=static_cast<std::size_t>( std::ranges::size(Input) );
+
+                unsigned int Count=::string_algo::algorithm::detail::resolve_concurrency(
+                    Concurrency, Segments, parallel_join_min_segments );
+
+                if( Count<=1 )
+                {
+                    return ::string_algo::algorithm::detail::join_impl<ResultT>(
+                        Input, Separator, join_allF() );
+                }
+
+                auto InputBegin=std::ranges::begin(Input);
+                std::size_t SeparatorSize=::string_algo::algorithm::detail::segment_size(Separator);
+
+                // Sizes of the chunks, the separator precedes every segment except the first one
+                std::vector<std::size_t> Offsets(Count+1, 0);
+                ::string_algo::algorithm::detail::run_parallel( Count,
+                    [&]( unsigned int Index )
+                    {
+                        std::size_t Begin=Segments/Count*Index;
+                        std::size_t End=( Index+1==Count ) ? Segments : Segments/Count*( Index+1 );
+
+                        std::size_t Size=( Index==0 ) ? 0 : SeparatorSize;
+                        for( std::size_t Segment=Begin; Segment<End; ++Segment )
+                        {
+                            Size+=::string_algo::algorithm::detail::segment_size( InputBegin[Segment] );
+                        }
+                        Offsets[Index]=Size+( End-Begin-1 )*SeparatorSize;
+                    } );
+
+                std::exclusive_scan( Offsets.begin(), Offsets.end(), Offsets.begin(), std::size_t(0) );
+
+                ResultT Result;
+                Result.resize( Offsets[Count] );
+                auto* Data=std::ranges::data(Result);
+
+                // Copy every chunk to its final position
+                ::string_algo::algorithm::detail::run_parallel( Count,
+                    [&]( unsigned int Index )
+                    {
+                        std::size_t Begin=Segments/Count*Index;
+                        std::size_t End=( Index+1==Count ) ? Segments : Segments/Count*( Index+1 );
+
+                        auto* Output=Data+Offsets[Index];
+                        for( std::size_t Segment=Begin; Segment<End; ++Segment )
+                        {
+                            if( Segment!=0 )
+                            {
+                                Output=::string_algo::algorithm::detail::copy_segment( Output, Separator );
+                            }
+                            Output=::string_algo::algorithm::detail::copy_segment( Output, InputBegin[Segment] );
+                        }
+                    } );
+
+                return Result;
+            }
+
+        } // namespace detail
+    } // namespace algorithm
+} // namespace string_algo
+
+#endif  // STRING_JOIN_DETAIL_HPP
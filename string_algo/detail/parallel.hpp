@@ -0,0 +1,96 @@
+
+#ifndef STRING_PARALLEL_DETAIL_HPP
+#define STRING_PARALLEL_DETAIL_HPP
+
+#include <cstddef>
+#include <exception>
+#include <thread>
+#include <vector>
+
+namespace string_algo {
+    namespace algorithm {
+        namespace detail {
+
+//  worker count selection  -----------------------------------------------//
+
+            // Resolve the number of workers used for a parallel algorithm
+            /*
+                Concurrency==0 selects std::thread::hardware_concurrency().
+                The result is capped so that every worker gets at least
+                MinWork units of work, and it is never less than 1.
+            */
+            inline unsigned int resolve_concurrency(
+                unsigned int Concurrency,
+                std::size_t Work,
+                std::size_t MinWork )
+            {
+                if( Concurrency==0 )
+                {
+                    Concurrency=std::thread::hardware_concurrency();
+                }
+
+                std::size_t MaxWorkers=( MinWork==0 ) ? Work : Work/MinWork;
+                if( MaxWorkers<Concurrency )
+                {
+                    Concurrency=static_cast<unsigned int>(MaxWorkers);
+                }
+
+                return Concurrency==0 ? 1 : Concurrency;
+            }
+
+//  parallel run  ---------------------------------------------------------//
+
+            // Run Fn(Index) for every Index in [0,Count) on its own thread
+            /*
+                Index 0 is executed on the calling thread. All workers are
+                joined before returning; the first exception thrown by a worker
+                is rethrown afterwards.
+            */
+            template< typename FunctionT >
+            inline void run_parallel( unsigned int Count, FunctionT Fn )
+            {
+                if( Count<=1 )
+                {
+                    Fn(0u);
+                    return;
+                }
+
+                std::vector<std::exception_ptr> Errors(Count);
+                std::vector<std::thread> Workers;
+                Workers.reserve(Count-1);
+
+                try
+                {
+                    for( unsigned int Index=1; Index<Count; ++Index )
+                    {
+                        Workers.emplace_back(
+                            [&Fn, &Errors, Index]()
+                            {
+                                try { Fn(Index); }
+                                catch(...) { Errors[Index]=std::current_exception(); }
+                            } );
+                    }
+
+                    Fn(0u);
+                }
+                catch(...)
+                {
+                    Errors[0]=std::current_exception();
+                }
+
+                for( std::thread& Worker : Workers )
+                {
+                    Worker.join();
+                }
+
+                for( const std::exception_ptr& Error : Errors )
+                {
+                    if( Error ) std::rethrow_exception(Error);
+                }
+            }
+
+        } // namespace detail
+    } // namespace algorithm
+} // namespace string_algo
+
+#endif  // STRING_PARALLEL_DETAIL_HPP
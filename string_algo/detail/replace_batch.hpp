@@ -0,0 +1,161 @@
+
+#ifndef STRING_REPLACE_BATCH_DETAIL_HPP
+#define STRING_REPLACE_BATCH_DETAIL_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "parallel.hpp"
+#include "sequence.hpp"
+#include "simd.hpp"
+
+namespace string_algo {
+    namespace algorithm {
+        namespace detail {
+
+//  compiled searcher  ------------------------------------------------------//
+
+            // Substring searcher shared by the workers of a batch
+            /*
+                The search string is copied and preprocessed once. A single
+                character is searched by memchr, longer strings by the
+                Boyer-Moore-Horspool algorithm. The searcher is immutable
+                after construction and can be used by several threads.
+            */
+            template< typename CharT >
+            class batch_searcher
+            {
+            public:
+                typedef std::basic_string_view<CharT> view_type;
+
+                explicit batch_searcher( view_type Search ) :
+                    m_Search( Search ),
+                    m_Searcher( m_Search.data(), m_Search.data()+m_Search.size() ) {}
+
+                batch_searcher( const batch_searcher& )=delete;
+                batch_searcher& operator=( const batch_searcher& )=delete;
+
+                // Size of the search string
+                std::size_t size() const { return m_Search.size(); }
+
+                // Find the first occurrence in Input at or after From
+                /*
+                    Returns Input.size() if there is none.
+                */
+                std::size_t find( view_type Input, std::size_t From ) const
+                {
+                    const CharT* First=Input.data()+From;
+                    const CharT* Last=Input.data()+Input.size();
+
+                    if( m_Search.empty() )
+                    {
+                        return Input.size();
+                    }
+
+                    const CharT* Found;
+                    if( m_Search.size()==1 )
+                    {
+                        Found=::string_algo::algorithm::detail::find_char( First, Last, m_Search[0] );
+                    }
+                    else
+                    {
+                        Found=m_Searcher( First, Last ).first;
+                    }
+
+                    return static_cast<std::size_t>( Found-Input.data() );
+                }
+
+            private:
+                std::basic_string<CharT> m_Search;
+                std::boyer_moore_horspool_searcher<const CharT*> m_Searcher;
+            };
+
+//  single record replace  --------------------------------------------------//
+
+            // Replace all occurrences of the search string, storing the result to Output
+            /*
+                Output is cleared before it is filled, its capacity is reused.
+                Returns false and leaves Output untouched if there is no match.
+            */
+            template< typename SequenceT, typename CharT >
+            inline bool replace_all_searcher(
+                SequenceT& Output,
+                std::basic_string_view<CharT> Input,
+                const batch_searcher<CharT>& Searcher,
+                std::basic_string_view<CharT> Format )
+            {
+                std::size_t Match=Searcher.find( Input, 0 );
+                if( Match==Input.size() )
+                {
+                    return false;
+                }
+
+                Output.clear();
+                ::string_algo::algorithm::detail::reserve( Output, Input.size() );
+
+                std::size_t Next=0;
+                while( Match!=Input.size() )
+                {
+                    Output.append( Input.data()+Next, Match-Next );
+                    Output.append( Format.data(), Format.size() );
+
+                    Next=Match+Searcher.size();
+                    Match=Searcher.find( Input, Next );
+                }
+                Output.append( Input.data()+Next, Input.size()-Next );
+
+                return true;
+            }
+
+//  batch scheduling  -------------------------------------------------------//
+
+            // Minimal number of records processed by one batch worker
+            const std::size_t replace_batch_min_records=256;
+
+            // Number of records claimed by a worker at once
+            const std::size_t replace_batch_block=64;
+
+            // Run Fn(Worker, Record) for every record in [0,Count) on Workers threads
+            /*
+                Records are claimed in blocks from a shared counter, so a worker
+                which finished its block takes the next free one. This balances
+                records of uneven size between the workers.
+            */
+            template< typename FunctionT >
+            inline void run_batch( std::size_t Count, unsigned int Workers, FunctionT Fn )
+            {
+                std::atomic<std::size_t> Next(0);
+                ::string_algo::algorithm::detail::run_parallel( Workers,
+                    [&]( unsigned int Worker )
+                    {
+                        for(;;)
+                        {
+                            std::size_t Begin=Next.fetch_add( replace_batch_block, std::memory_order_relaxed );
+                            if( Begin>=Count ) break;
+
+                            std::size_t End=( Count-Begin<replace_batch_block ) ? Count : Begin+replace_batch_block;
+                            for( std::size_t Record=Begin; Record<End; ++Record )
+                            {
+                                Fn( Worker, Record );
+                            }
+                        }
+                    } );
+            }
+
+            // Per worker scratch buffer, kept on its own cache line
+            template< typename SequenceT >
+            struct alignas(64) batch_scratch
+            {
+                SequenceT Buffer;
+            };
+
+        } // namespace detail
+    } // namespace algorithm
+} // namespace string_algo
+
+#endif  // STRING_REPLACE_BATCH_DETAIL_HPP
@@ -3,6 +3,12 @@
 #ifndef STRING_DETAIL_SEQUENCE_HPP
 #define STRING_DETAIL_SEQUENCE_HPP
 
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+#include <type_traits>
+#include <version>
+
 #include "../sequence_traits.hpp"
 
 namespace string_algo {
@@ -178,6 +184,73 @@ namespace string_algo {
 				}
 			}
 
+			//  contiguous sequence helpers  -----------------------------------//
+
+			// Check if a sequence is contiguous and can be resized
+			template< typename SequenceT >
+			struct is_contiguous_sequence :
+				std::bool_constant<
+					std::ranges::contiguous_range<SequenceT> &&
+					requires( SequenceT& Seq ) { Seq.resize( std::size_t() ); } > {};
+
+			// Resize a contiguous sequence and fill it using Fill(pointer)
+			/*
+				Uses resize_and_overwrite for strings when available, so the
+				new content is not zero-initialized first. The size passed to
+				the operation is not used, some library versions pass the capacity.
+			*/
+			template< typename SequenceT, typename FillT >
+			inline void resize_and_fill( SequenceT& Output, std::size_t Size, FillT Fill )
+			{
+#if defined(__cpp_lib_string_resize_and_overwrite)
+				if constexpr( requires { Output.resize_and_overwrite( Size, [](auto*, std::size_t N) { return N; } ); } )
+				{
+					Output.resize_and_overwrite( Size,
+						[&Fill, Size]( auto* Data, std::size_t )
+						{
+							Fill( Data );
+							return Size;
+						} );
+					return;
+				}
+#endif
+				Output.resize( Size );
+				Fill( std::ranges::data(Output) );
+			}
+
+			// Resize a contiguous sequence to at most MaxSize and fill it using Fill(pointer)
+			/*
+				Fill returns the number of elements actually written, the sequence
+				is truncated to it.
+			*/
+			template< typename SequenceT, typename FillT >
+			inline void resize_and_truncate( SequenceT& Output, std::size_t MaxSize, FillT Fill )
+			{
+#if defined(__cpp_lib_string_resize_and_overwrite)
+				if constexpr( requires { Output.resize_and_overwrite( MaxSize, [](auto*, std::size_t N) { return N; } ); } )
+				{
+					Output.resize_and_overwrite( MaxSize,
+						[&Fill]( auto* Data, std::size_t )
+						{
+							return static_cast<std::size_t>( Fill( Data ) );
+						} );
+					return;
+				}
+#endif
+				Output.resize( MaxSize );
+				Output.resize( static_cast<std::size_t>( Fill( std::ranges::data(Output) ) ) );
+			}
+
+			// Reserve space in a sequence, if it supports it
+			template< typename SequenceT >
+			inline void reserve( SequenceT& Output, std::size_t Size )
+			{
+				if constexpr( requires { Output.reserve(Size); } )
+				{
+					Output.reserve( Size );
+				}
+			}
+
 		} // namespace detail
 	} // namespace algorithm
 } // namespace string_algo
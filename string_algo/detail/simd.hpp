@@ -0,0 +1,425 @@
+
+#ifndef STRING_SIMD_DETAIL_HPP
+#define STRING_SIMD_DETAIL_HPP
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+// SSE2 is part of the x86-64 baseline. Define STRING_ALGO_NO_SIMD to force the scalar code.
+#if !defined(STRING_ALGO_NO_SIMD) && ( defined(__SSE2__) || defined(_M_X64) || ( defined(_M_IX86_FP) && _M_IX86_FP>=2 ) )
+#define STRING_ALGO_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace string_algo {
+    namespace algorithm {
+        namespace detail {
+
+//  byte character check  -------------------------------------------------//
+
+            // Vector kernels operate on one byte character types only
+            template< typename CharT >
+            struct is_byte_char :
+                std::bool_constant< sizeof(CharT)==1 && std::is_integral_v<CharT> > {};
+
+//  byte set  ------------------------------------------------------------//
+
+            // Set of byte values
+            /*
+                Membership is kept in a 256-bit table. Up to max_vector_size
+                distinct members are also kept in a list, so that the set can
+                be matched by vector compares.
+            */
+            class byte_set
+            {
+            public:
+                static const unsigned int max_vector_size=16;
+
+                byte_set() : m_Size(0)
+                {
+                    m_Table[0]=m_Table[1]=m_Table[2]=m_Table[3]=0;
+                }
+
+                // Add a value to the set
+                void insert( unsigned char Ch )
+                {
+                    if( contains(Ch) ) return;
+
+                    m_Table[Ch>>6]|=std::uint64_t(1)<<(Ch&63);
+                    if( m_Size<max_vector_size )
+                    {
+                        m_Bytes[m_Size]=Ch;
+                    }
+                    ++m_Size;
+                }
+
+                // Add all values from a range
+                template< typename IteratorT >
+                void insert( IteratorT Begin, IteratorT End )
+                {
+                    for( ; Begin!=End; ++Begin )
+                    {
+                        insert( static_cast<unsigned char>(*Begin) );
+                    }
+                }
+
+                // Membership test
+                bool contains( unsigned char Ch ) const
+                {
+                    return ( m_Table[Ch>>6]>>(Ch&63) ) & 1;
+                }
+
+                // Number of members
+                unsigned int size() const { return m_Size; }
+
+                // Check if the set can be matched by vector compares
+                bool is_vector() const { return m_Size<=max_vector_size; }
+
+                // Members, valid only if is_vector()
+                const unsigned char* bytes() const { return m_Bytes; }
+
+            private:
+                std::uint64_t m_Table[4];
+                unsigned char m_Bytes[max_vector_size];
+                unsigned int m_Size;
+            };
+
+//  byte range set  ------------------------------------------------------//
+
+            // Set of byte values kept as a list of ranges
+            /*
+                Membership is kept in a 256-bit table. Up to max_vector_ranges
+                ranges of consecutive members are also kept, so that classes
+                like control characters or digits can be matched by vector
+                compares as well as small explicit sets.
+            */
+            class byte_range_set
+            {
+            public:
+                static const unsigned int max_vector_ranges=8;
+
+                byte_range_set() : m_Ranges(0)
+                {
+                    m_Table[0]=m_Table[1]=m_Table[2]=m_Table[3]=0;
+                }
+
+                // Tabulate a character predicate
+                /*
+                    Pred is evaluated once for every byte value converted to CharT.
+                */
+                template< typename CharT, typename PredicateT >
+                static byte_range_set from_predicate( const PredicateT& Pred )
+                {
+                    byte_range_set Set;
+                    for( unsigned int Ch=0; Ch<256; ++Ch )
+                    {
+                        if( Pred( static_cast<CharT>( static_cast<unsigned char>(Ch) ) ) )
+                        {
+                            Set.m_Table[Ch>>6]|=std::uint64_t(1)<<(Ch&63);
+                        }
+                    }
+
+                    // Collect the ranges
+                    for( unsigned int Ch=0; Ch<256; )
+                    {
+                        if( !Set.contains( static_cast<unsigned char>(Ch) ) )
+                        {
+                            ++Ch;
+                            continue;
+                        }
+
+                        unsigned int Low=Ch;
+                        while( Ch<256 && Set.contains( static_cast<unsigned char>(Ch) ) ) ++Ch;
+
+                        if( Set.m_Ranges<max_vector_ranges )
+                        {
+                            Set.m_Low[Set.m_Ranges]=static_cast<unsigned char>(Low);
+                            Set.m_Width[Set.m_Ranges]=static_cast<unsigned char>(Ch-1-Low);
+                        }
+                        ++Set.m_Ranges;
+                    }
+
+                    return Set;
+                }
+
+                // Membership test
+                bool contains( unsigned char Ch ) const
+                {
+                    return ( m_Table[Ch>>6]>>(Ch&63) ) & 1;
+                }
+
+                // Check if the set has no members
+                bool empty() const { return m_Ranges==0; }
+
+                // Number of ranges
+                unsigned int ranges() const { return m_Ranges; }
+
+                // Check if the set can be matched by vector compares
+                bool is_vector() const { return m_Ranges<=max_vector_ranges; }
+
+                // The first members of the ranges, valid only if is_vector()
+                const unsigned char* low() const { return m_Low; }
+
+                // Distances between the last and the first members of the ranges, valid only if is_vector()
+                const unsigned char* width() const { return m_Width; }
+
+            private:
+                std::uint64_t m_Table[4];
+                unsigned char m_Low[max_vector_ranges];
+                unsigned char m_Width[max_vector_ranges];
+                unsigned int m_Ranges;
+            };
+
+//  vector match  ---------------------------------------------------------//
+
+#if defined(STRING_ALGO_SSE2)
+
+            // Broadcast members of a vector byte set
+            struct byte_set_vectors
+            {
+                explicit byte_set_vectors( const byte_set& Set ) : m_Size(Set.size())
+                {
+                    for( unsigned int Index=0; Index<m_Size; ++Index )
+                    {
+                        m_Vectors[Index]=_mm_set1_epi8( static_cast<char>(Set.bytes()[Index]) );
+                    }
+                }
+
+                // Bit mask of the bytes of Block, which are members of the set
+                unsigned int match( __m128i Block ) const
+                {
+                    __m128i Mask=_mm_setzero_si128();
+                    for( unsigned int Index=0; Index<m_Size; ++Index )
+                    {
+                        Mask=_mm_or_si128( Mask, _mm_cmpeq_epi8( Block, m_Vectors[Index] ) );
+                    }
+                    return static_cast<unsigned int>( _mm_movemask_epi8(Mask) );
+                }
+
+                __m128i m_Vectors[byte_set::max_vector_size];
+                unsigned int m_Size;
+            };
+
+            // Broadcast ranges of a vector byte range set
+            struct byte_range_vectors
+            {
+                explicit byte_range_vectors( const byte_range_set& Set ) : m_Size(Set.ranges())
+                {
+                    for( unsigned int Index=0; Index<m_Size; ++Index )
+                    {
+                        m_Low[Index]=_mm_set1_epi8( static_cast<char>(Set.low()[Index]) );
+                        m_Width[Index]=_mm_set1_epi8( static_cast<char>(Set.width()[Index]) );
+                    }
+                }
+
+                // Bit mask of the bytes of Block, which are members of the set
+                /*
+                    A byte is in [Low,Low+Width] iff Byte-Low, wrapped around,
+                    is not greater than Width as an unsigned value.
+                */
+                unsigned int match( __m128i Block ) const
+                {
+                    __m128i Mask=_mm_setzero_si128();
+                    for( unsigned int Index=0; Index<m_Size; ++Index )
+                    {
+                        __m128i Offset=_mm_sub_epi8( Block, m_Low[Index] );
+                        Mask=_mm_or_si128( Mask,
+                            _mm_cmpeq_epi8( _mm_min_epu8( Offset, m_Width[Index] ), Offset ) );
+                    }
+                    return static_cast<unsigned int>( _mm_movemask_epi8(Mask) );
+                }
+
+                __m128i m_Low[byte_range_set::max_vector_ranges];
+                __m128i m_Width[byte_range_set::max_vector_ranges];
+                unsigned int m_Size;
+            };
+
+#endif
+
+//  find kernels  ---------------------------------------------------------//
+
+            // Find the first occurrence of a character
+            /*
+                Uses memchr for byte characters, which is vectorized by the
+                runtime library. Returns Last if there is no such character.
+            */
+            template< typename CharT >
+            inline const CharT* find_char(
+                const CharT* First,
+                const CharT* Last,
+                CharT Ch )
+            {
+                if constexpr( is_byte_char<CharT>::value )
+                {
+                    const void* Found=std::memchr( First, static_cast<unsigned char>(Ch), static_cast<std::size_t>(Last-First) );
+                    return Found ? static_cast<const CharT*>(Found) : Last;
+                }
+                else
+                {
+                    for( ; First!=Last; ++First )
+                    {
+                        if( *First==Ch ) return First;
+                    }
+                    return Last;
+                }
+            }
+
+            // Find the first byte, which is a member of the set
+            /*
+                Returns Last if there is no such byte.
+            */
+            template< typename CharT >
+            inline const CharT* find_first_of_set(
+                const CharT* First,
+                const CharT* Last,
+                const byte_set& Set )
+            {
+                static_assert( is_byte_char<CharT>::value, "byte character type required" );
+
+                if( Set.size()==1 )
+                {
+                    const void* Found=std::memchr( First, Set.bytes()[0], static_cast<std::size_t>(Last-First) );
+                    return Found ? static_cast<const CharT*>(Found) : Last;
+                }
+
+#if defined(STRING_ALGO_SSE2)
+                if( Set.is_vector() && Last-First>=16 )
+                {
+                    byte_set_vectors Vectors(Set);
+                    for( ; Last-First>=16; First+=16 )
+                    {
+                        unsigned int Mask=Vectors.match(
+                            _mm_loadu_si128( reinterpret_cast<const __m128i*>(First) ) );
+                        if( Mask!=0 )
+                        {
+                            return First+std::countr_zero(Mask);
+                        }
+                    }
+                }
+#endif
+
+                for( ; First!=Last; ++First )
+                {
+                    if( Set.contains( static_cast<unsigned char>(*First) ) ) return First;
+                }
+
+                return Last;
+            }
+
+            // Find the first byte, which is a member of the range set
+            /*
+                Returns Last if there is no such byte.
+            */
+            template< typename CharT >
+            inline const CharT* find_first_of_ranges(
+                const CharT* First,
+                const CharT* Last,
+                const byte_range_set& Set )
+            {
+                static_assert( is_byte_char<CharT>::value, "byte character type required" );
+
+#if defined(STRING_ALGO_SSE2)
+                if( Set.is_vector() && Last-First>=16 )
+                {
+                    byte_range_vectors Vectors(Set);
+                    for( ; Last-First>=16; First+=16 )
+                    {
+                        unsigned int Mask=Vectors.match(
+                            _mm_loadu_si128( reinterpret_cast<const __m128i*>(First) ) );
+                        if( Mask!=0 )
+                        {
+                            return First+std::countr_zero(Mask);
+                        }
+                    }
+                }
+#endif
+
+                for( ; First!=Last; ++First )
+                {
+                    if( Set.contains( static_cast<unsigned char>(*First) ) ) return First;
+                }
+
+                return Last;
+            }
+
+            // Find the first byte, which is not a member of the range set
+            /*
+                Returns Last if there is no such byte.
+            */
+            template< typename CharT >
+            inline const CharT* find_first_not_of_ranges(
+                const CharT* First,
+                const CharT* Last,
+                const byte_range_set& Set )
+            {
+                static_assert( is_byte_char<CharT>::value, "byte character type required" );
+
+#if defined(STRING_ALGO_SSE2)
+                if( Set.is_vector() && Last-First>=16 )
+                {
+                    byte_range_vectors Vectors(Set);
+                    for( ; Last-First>=16; First+=16 )
+                    {
+                        unsigned int Mask=~Vectors.match(
+                            _mm_loadu_si128( reinterpret_cast<const __m128i*>(First) ) ) & 0xFFFF;
+                        if( Mask!=0 )
+                        {
+                            return First+std::countr_zero(Mask);
+                        }
+                    }
+                }
+#endif
+
+                for( ; First!=Last; ++First )
+                {
+                    if( !Set.contains( static_cast<unsigned char>(*First) ) ) return First;
+                }
+
+                return Last;
+            }
+
+            // Find the last byte, which is not a member of the range set
+            /*
+                Returns the position just after that byte, or First if there is
+                no such byte. Blocks are scanned backwards from Last.
+            */
+            template< typename CharT >
+            inline const CharT* find_last_not_of_ranges(
+                const CharT* First,
+                const CharT* Last,
+                const byte_range_set& Set )
+            {
+                static_assert( is_byte_char<CharT>::value, "byte character type required" );
+
+#if defined(STRING_ALGO_SSE2)
+                if( Set.is_vector() && Last-First>=16 )
+                {
+                    byte_range_vectors Vectors(Set);
+                    for( ; Last-First>=16; Last-=16 )
+                    {
+                        unsigned int Mask=~Vectors.match(
+                            _mm_loadu_si128( reinterpret_cast<const __m128i*>(Last-16) ) ) & 0xFFFF;
+                        if( Mask!=0 )
+                        {
+                            return Last-std::countl_zero(Mask)+16;
+                        }
+                    }
+                }
+#endif
+
+                for( ; Last!=First; --Last )
+                {
+                    if( !Set.contains( static_cast<unsigned char>(Last[-1]) ) ) return Last;
+                }
+
+                return First;
+            }
+
+        } // namespace detail
+    } // namespace algorithm
+} // namespace string_algo
+
+#endif  // STRING_SIMD_DETAIL_HPP
@@ -0,0 +1,339 @@
+
+#ifndef STRING_SPLIT_DETAIL_HPP
+#define STRING_SPLIT_DETAIL_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <numeric>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../constants.hpp"
+#include "../token_columns.hpp"
+#include "finder.hpp"
+#include "parallel.hpp"
+#include "simd.hpp"
+#include "trim.hpp"
+
+namespace string_algo {
+    namespace algorithm {
+        namespace detail {
+
+//  chunk tokenizer  -----------------------------------------------------//
+
+            // Tokenize [Begin,End) of the input with a token finder
+            /*
+                Emits Token(Offset,Length) for every gap between two separators,
+                exactly like split_iterator does. Offsets are relative to the
+                beginning of Input. If SkipFirst is set, the first token is not
+                emitted (used for chunks starting on a separator).
+            */
+            template< typename CharT, typename FinderT, typename TokenT >
+            inline void split_chunk(
+                std::span<CharT> Input,
+                std::size_t Begin,
+                std::size_t End,
+                const FinderT& Finder,
+                bool SkipFirst,
+                TokenT Token )
+            {
+                typedef typename std::span<CharT>::iterator input_iterator_type;
+
+                input_iterator_type InputBegin=Input.begin();
+                input_iterator_type ChunkEnd=InputBegin+End;
+
+                std::size_t Next=Begin;
+                for(;;)
+                {
+                    auto M=Finder( InputBegin+Next, ChunkEnd );
+                    std::size_t MatchBegin=static_cast<std::size_t>(M.data()-Input.data());
+
+                    if( !SkipFirst )
+                    {
+                        Token( Next, MatchBegin-Next );
+                    }
+                    SkipFirst=false;
+
+                    if( M.empty() )
+                    {
+                        // No more separators
+                        break;
+                    }
+
+                    Next=MatchBegin+M.size();
+                }
+            }
+
+//  bounded tokenizer  ---------------------------------------------------//
+
+            // Tokenize the input, stopping after Capacity tokens
+            /*
+                Emits Token(Offset,Length) for at most Capacity tokens, with the
+                same semantics as split_chunk over a token finder. The predicate is
+                used by reference, so no copy of it is made.
+                Returns the offset of the part of the input which was not tokenized,
+                or Input.size()+1 if the whole input has been consumed.
+            */
+            template< typename CharT, typename PredicateT, typename TokenT >
+            inline std::size_t split_bounded(
+                std::span<CharT> Input,
+                std::size_t Capacity,
+                const PredicateT& Pred,
+                token_compress_mode_type eCompress,
+                TokenT Token ) noexcept
+            {
+                std::size_t Size=Input.size();
+                std::size_t Next=0;
+
+                for( std::size_t Count=0; Count<Capacity; ++Count )
+                {
+                    std::size_t Pos=Next;
+                    while( Pos<Size && !Pred(Input[Pos]) ) ++Pos;
+
+                    Token( Next, Pos-Next );
+
+                    if( Pos==Size )
+                    {
+                        return Size+1;
+                    }
+
+                    // Skip the separator
+                    ++Pos;
+                    if( eCompress==token_compress_on )
+                    {
+                        while( Pos<Size && Pred(Input[Pos]) ) ++Pos;
+                    }
+
+                    Next=Pos;
+                }
+
+                return Next;
+            }
+
+//  key/value split  -----------------------------------------------------//
+
+            // Trim mode tag for split_kv_impl, no trimming is performed
+            struct kv_no_trimF {};
+
+            // Split the input into key/value pairs in a single pass
+            /*
+                Pairs are delimited by any of PairDelims, a key is separated from
+                its value by the first KvDelim in the pair. A pair without KvDelim
+                has an empty value, empty pairs are skipped.
+                Emits Pair(Key,Value) with views of the input. If Trim is not
+                kv_no_trimF, it is used to trim both keys and values.
+            */
+            template< typename CharT, typename DelimRangeT, typename TrimT, typename PairT >
+            inline void split_kv_impl(
+                std::span<CharT> Input,
+                const DelimRangeT& PairDelims,
+                std::remove_const_t<CharT> KvDelim,
+                const TrimT& Trim,
+                PairT Pair )
+            {
+                typedef std::remove_const_t<CharT> char_type;
+                typedef std::basic_string_view<char_type> view_type;
+
+                const char_type* Begin=Input.data();
+                const char_type* End=Begin+Input.size();
+
+                // Delimiter lookup structures
+                byte_set PairSet;
+                byte_set AnySet;
+                if constexpr( is_byte_char<char_type>::value )
+                {
+                    PairSet.insert( ::std::begin(PairDelims), ::std::end(PairDelims) );
+                    AnySet=PairSet;
+                    AnySet.insert( static_cast<unsigned char>(KvDelim) );
+                }
+
+                auto IsPairDelim=[&]( char_type Ch ) -> bool
+                {
+                    if constexpr( is_byte_char<char_type>::value )
+                    {
+                        return PairSet.contains( static_cast<unsigned char>(Ch) );
+                    }
+                    else
+                    {
+                        return std::find( ::std::begin(PairDelims), ::std::end(PairDelims), Ch )!=::std::end(PairDelims);
+                    }
+                };
+
+                auto FindDelim=[&]( const char_type* First ) -> const char_type*
+                {
+                    if constexpr( is_byte_char<char_type>::value )
+                    {
+                        return ::string_algo::algorithm::detail::find_first_of_set( First, End, AnySet );
+                    }
+                    else
+                    {
+                        return std::find_if( First, End,
+                            [&]( char_type Ch ) { return Ch==KvDelim || IsPairDelim(Ch); } );
+                    }
+                };
+
+                auto Emit=[&]( const char_type* First, const char_type* Last ) -> view_type
+                {
+                    if constexpr( !std::is_same_v<TrimT, kv_no_trimF> )
+                    {
+                        Last=::string_algo::algorithm::detail::trim_end( First, Last, Trim );
+                        First=::string_algo::algorithm::detail::trim_begin( First, Last, Trim );
+                    }
+                    return view_type( First, static_cast<std::size_t>(Last-First) );
+                };
+
+                const char_type* PairBegin=Begin;
+                const char_type* KvPos=nullptr;
+
+                for( const char_type* It=FindDelim(Begin);; It=FindDelim(It+1) )
+                {
+                    if( It!=End && !IsPairDelim(*It) )
+                    {
+                        // Key/value delimiter, only the first one in a pair counts
+                        if( KvPos==nullptr ) KvPos=It;
+                        continue;
+                    }
+
+                    if( KvPos!=nullptr )
+                    {
+                        Pair( Emit( PairBegin, KvPos ), Emit( KvPos+1, It ) );
+                    }
+                    else
+                    {
+                        view_type Key=Emit( PairBegin, It );
+                        if( !Key.empty() )
+                        {
+                            Pair( Key, view_type( It, 0 ) );
+                        }
+                    }
+
+                    if( It==End ) break;
+
+                    PairBegin=It+1;
+                    KvPos=nullptr;
+                }
+            }
+
+//  parallel split  ------------------------------------------------------//
+
+            // Minimal number of elements processed by one parallel_split worker
+            const std::size_t parallel_split_min_chunk=std::size_t(1)<<16;
+
+            // Compute chunk boundaries for parallel_split
+            /*
+                Nominal boundaries are moved forward to the first separator,
+                and in compressed mode back to the start of the separator run,
+                so that neither a token nor a separator run is torn between chunks.
+                Every chunk except the first one starts on a separator.
+            */
+            template< typename CharT, typename PredicateT >
+            inline std::vector<std::size_t> split_chunk_bounds(
+                std::span<CharT> Input,
+                PredicateT& Pred,
+                token_compress_mode_type eCompress,
+                unsigned int Count )
+            {
+                std::size_t Size=Input.size();
+                std::vector<std::size_t> Bounds(Count+1, Size);
+                Bounds[0]=0;
+
+                for( unsigned int Index=1; Index<Count; ++Index )
+                {
+                    std::size_t Previous=Bounds[Index-1];
+                    std::size_t Start=std::max( Previous, Size/Count*Index );
+
+                    std::size_t Pos=static_cast<std::size_t>(
+                        std::find_if( Input.begin()+Start, Input.end(), Pred )-Input.begin() );
+
+                    if( eCompress==token_compress_on )
+                    {
+                        while( Pos>Previous && Pos<Size && Pred(Input[Pos-1]) ) --Pos;
+                    }
+
+                    Bounds[Index]=Pos;
+                }
+
+                return Bounds;
+            }
+
+            template< typename OffsetSequenceT, typename CharT, typename PredicateT >
+            inline void parallel_split_impl(
+                OffsetSequenceT& Result,
+                std::span<CharT> Input,
+                PredicateT Pred,
+                token_compress_mode_type eCompress,
+                unsigned int Concurrency )
+            {
+                typedef std::pair<std::size_t, std::size_t> token_type;
+
+                unsigned int Count=::string_algo::algorithm::detail::resolve_concurrency(
+                    Concurrency, Input.size(), parallel_split_min_chunk );
+
+                std::vector<std::size_t> Bounds=
+                    ::string_algo::algorithm::detail::split_chunk_bounds( Input, Pred, eCompress, Count );
+
+                token_finderF<PredicateT> Finder( Pred, eCompress );
+
+                // Tokenize every chunk independently
+                std::vector< std::vector<token_type> > Tokens(Count);
+                ::string_algo::algorithm::detail::run_parallel( Count,
+                    [&]( unsigned int Index )
+                    {
+                        std::vector<token_type>& Local=Tokens[Index];
+                        ::string_algo::algorithm::detail::split_chunk(
+                            Input, Bounds[Index], Bounds[Index+1], Finder, Index!=0,
+                            [&Local]( std::size_t Offset, std::size_t Length )
+                            {
+                                Local.emplace_back( Offset, Length );
+                            } );
+                    } );
+
+                // Exclusive prefix sum of the token counts gives the output positions
+                std::vector<std::size_t> Positions(Count+1, 0);
+                for( unsigned int Index=0; Index<Count; ++Index )
+                {
+                    Positions[Index]=Tokens[Index].size();
+                }
+                std::exclusive_scan( Positions.begin(), Positions.end(), Positions.begin(), std::size_t(0) );
+
+                if constexpr( is_token_columns<OffsetSequenceT>::value )
+                {
+                    // Fill the offset and length columns directly
+                    Result.assign_input( Input.data(), Input.size() );
+                    Result.resize( Positions[Count] );
+
+                    ::string_algo::algorithm::detail::run_parallel( Count,
+                        [&]( unsigned int Index )
+                        {
+                            std::size_t Position=Positions[Index];
+                            for( const token_type& Token : Tokens[Index] )
+                            {
+                                Result.set( Position++, Token.first, Token.second );
+                            }
+                        } );
+                }
+                else
+                {
+                    Result.clear();
+                    Result.resize( Positions[Count] );
+
+                    ::string_algo::algorithm::detail::run_parallel( Count,
+                        [&]( unsigned int Index )
+                        {
+                            auto It=::std::begin(Result)+Positions[Index];
+                            for( const token_type& Token : Tokens[Index] )
+                            {
+                                *It++=typename OffsetSequenceT::value_type( Token.first, Token.second );
+                            }
+                        } );
+                }
+            }
+
+        } // namespace detail
+    } // namespace algorithm
+} // namespace string_algo
+
+#endif  // STRING_SPLIT_DETAIL_HPP
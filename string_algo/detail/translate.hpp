@@ -0,0 +1,422 @@
+
+#ifndef STRING_TRANSLATE_DETAIL_HPP
+#define STRING_TRANSLATE_DETAIL_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+#include <type_traits>
+
+#include "erase.hpp"
+#include "sequence.hpp"
+#include "simd.hpp"
+
+namespace string_algo {
+    namespace algorithm {
+        namespace detail {
+
+//  translate  -------------------------------------------------------------//
+
+            // Mapping of a character to its translation
+            /*
+                From[i] is mapped to To[i]. If To is shorter, the remaining characters
+                of From are mapped to the last character of To. An empty To leaves
+                all characters unchanged. If a character occurs in From several times,
+                the last occurrence counts.
+            */
+            template< typename FromIteratorT, typename ToIteratorT, typename CharT >
+            inline bool translate_lookup(
+                FromIteratorT FromBegin,
+                FromIteratorT FromEnd,
+                ToIteratorT ToBegin,
+                ToIteratorT ToEnd,
+                CharT Ch,
+                CharT& Result )
+            {
+                bool bFound=false;
+                ToIteratorT To=ToBegin;
+                for( FromIteratorT From=FromBegin; From!=FromEnd && ToBegin!=ToEnd; ++From )
+                {
+                    if( *From==Ch )
+                    {
+                        Result=*To;
+                        bFound=true;
+                    }
+
+                    ToIteratorT Next=To;
+                    if( ++Next!=ToEnd ) To=Next;
+                }
+                return bFound;
+            }
+
+            // Translation table for byte characters
+            /*
+                Keeps the 256 entry map and the list of bytes, which are changed
+                by the translation. Up to 16 changed bytes are translated 16 bytes
+                at a time by comparing the block with each of them.
+            */
+            class translate_table
+            {
+            public:
+                static const unsigned int max_vector_pairs=16;
+
+            public:
+                template< typename FromIteratorT, typename ToIteratorT >
+                translate_table(
+                    FromIteratorT FromBegin,
+                    FromIteratorT FromEnd,
+                    ToIteratorT ToBegin,
+                    ToIteratorT ToEnd ) : m_Pairs(0)
+                {
+                    for( unsigned int Ch=0; Ch<256; ++Ch )
+                    {
+                        m_Map[Ch]=static_cast<unsigned char>(Ch);
+                    }
+
+                    ToIteratorT To=ToBegin;
+                    for( FromIteratorT From=FromBegin; From!=FromEnd && ToBegin!=ToEnd; ++From )
+                    {
+                        m_Map[static_cast<unsigned char>(*From)]=static_cast<unsigned char>(*To);
+
+                        ToIteratorT Next=To;
+                        if( ++Next!=ToEnd ) To=Next;
+                    }
+
+                    for( unsigned int Ch=0; Ch<256; ++Ch )
+                    {
+                        if( m_Map[Ch]!=Ch )
+                        {
+                            if( m_Pairs<max_vector_pairs )
+                            {
+                                m_From[m_Pairs]=static_cast<unsigned char>(Ch);
+                                m_To[m_Pairs]=m_Map[Ch];
+                            }
+                            ++m_Pairs;
+                        }
+                    }
+                }
+
+                unsigned char map( unsigned char Ch ) const { return m_Map[Ch]; }
+
+                // Check if the translation does not change any character
+                bool empty() const { return m_Pairs==0; }
+
+                bool is_vector() const { return m_Pairs<=max_vector_pairs; }
+
+                unsigned int pairs() const { return m_Pairs; }
+                const unsigned char* from() const { return m_From; }
+                const unsigned char* to() const { return m_To; }
+
+            private:
+                unsigned char m_Map[256];
+                unsigned char m_From[max_vector_pairs];
+                unsigned char m_To[max_vector_pairs];
+                unsigned int m_Pairs;
+            };
+
+            // Translate [First,Last) to Output
+            /*
+                Output may be equal to First, unchanged blocks are not stored then.
+            */
+            template< typename CharT >
+            inline void translate_bytes(
+                const CharT* First,
+                const CharT* Last,
+                CharT* Output,
+                const translate_table& Table )
+            {
+                static_assert( is_byte_char<CharT>::value, "byte character type required" );
+
+                if( Table.empty() )
+                {
+                    if( First!=Output ) std::copy( First, Last, Output );
+                    return;
+                }
+
+#if defined(STRING_ALGO_SSE2)
+                if( Table.is_vector() && Last-First>=16 )
+                {
+                    __m128i From[translate_table::max_vector_pairs];
+                    __m128i To[translate_table::max_vector_pairs];
+                    const unsigned int Pairs=Table.pairs();
+                    for( unsigned int Index=0; Index<Pairs; ++Index )
+                    {
+                        From[Index]=_mm_set1_epi8( static_cast<char>(Table.from()[Index]) );
+                        To[Index]=_mm_set1_epi8( static_cast<char>(Table.to()[Index]) );
+                    }
+
+                    const bool bInPlace=( First==Output );
+                    for( ; Last-First>=16; First+=16, Output+=16 )
+                    {
+                        __m128i Block=_mm_loadu_si128( reinterpret_cast<const __m128i*>(First) );
+                        __m128i Result=Block;
+                        __m128i Changed=_mm_setzero_si128();
+
+                        // Compare with the original block, so translations do not chain
+                        for( unsigned int Index=0; Index<Pairs; ++Index )
+                        {
+                            __m128i Mask=_mm_cmpeq_epi8( Block, From[Index] );
+                            Result=_mm_or_si128( _mm_andnot_si128( Mask, Result ), _mm_and_si128( Mask, To[Index] ) );
+                            Changed=_mm_or_si128( Changed, Mask );
+                        }
+
+                        if( !bInPlace || _mm_movemask_epi8(Changed)!=0 )
+                        {
+                            _mm_storeu_si128( reinterpret_cast<__m128i*>(Output), Result );
+                        }
+                    }
+                }
+#endif
+
+                for( ; First!=Last; ++First, ++Output )
+                {
+                    *Output=static_cast<CharT>( Table.map( static_cast<unsigned char>(*First) ) );
+                }
+            }
+
+            // Copy [First,Last) to an output iterator, translating the characters
+            template< typename OutputIteratorT, typename CharT, typename FromT, typename ToT >
+            inline OutputIteratorT translate_copy_impl(
+                OutputIteratorT Output,
+                const CharT* First,
+                const CharT* Last,
+                const FromT& From,
+                const ToT& To )
+            {
+                typedef std::remove_const_t<CharT> char_type;
+
+                if constexpr( is_byte_char<char_type>::value )
+                {
+                    translate_table Table( From.begin(), From.end(), To.begin(), To.end() );
+                    if constexpr( std::is_same_v<OutputIteratorT, char_type*> )
+                    {
+                        ::string_algo::algorithm::detail::translate_bytes( First, Last, Output, Table );
+                        return Output+( Last-First );
+                    }
+                    else
+                    {
+                        return std::transform( First, Last, Output,
+                            [&Table]( char_type Ch )
+                            {
+                                return static_cast<char_type>( Table.map( static_cast<unsigned char>(Ch) ) );
+                            } );
+                    }
+                }
+                else
+                {
+                    return std::transform( First, Last, Output,
+                        [&From, &To]( char_type Ch )
+                        {
+                            ::string_algo::algorithm::detail::translate_lookup(
+                                From.begin(), From.end(), To.begin(), To.end(), Ch, Ch );
+                            return Ch;
+                        } );
+                }
+            }
+
+            // Translate a sequence in-place
+            template< typename SequenceT, typename FromT, typename ToT >
+            inline void translate_impl( SequenceT& Input, const FromT& From, const ToT& To )
+            {
+                typedef std::ranges::range_value_t<SequenceT> char_type;
+
+                if constexpr( is_byte_char<char_type>::value && is_contiguous_sequence<SequenceT>::value )
+                {
+                    char_type* Data=std::ranges::data(Input);
+                    ::string_algo::algorithm::detail::translate_bytes(
+                        Data, Data+std::ranges::size(Input), Data,
+                        translate_table( From.begin(), From.end(), To.begin(), To.end() ) );
+                }
+                else if constexpr( is_byte_char<char_type>::value )
+                {
+                    translate_table Table( From.begin(), From.end(), To.begin(), To.end() );
+                    for( auto& Ch : Input )
+                    {
+                        Ch=static_cast<char_type>( Table.map( static_cast<unsigned char>(Ch) ) );
+                    }
+                }
+                else
+                {
+                    for( auto& Ch : Input )
+                    {
+                        ::string_algo::algorithm::detail::translate_lookup(
+                            From.begin(), From.end(), To.begin(), To.end(), Ch, Ch );
+                    }
+                }
+            }
+
+            // Copy variant of translate returning a sequence
+            template< typename SequenceT, typename FromT, typename ToT >
+            inline SequenceT translate_copy_impl( const SequenceT& Input, const FromT& From, const ToT& To )
+            {
+                SequenceT Output;
+
+                if constexpr( is_contiguous_sequence<SequenceT>::value )
+                {
+                    const auto* Data=std::ranges::data(Input);
+                    std::size_t Size=std::ranges::size(Input);
+
+                    ::string_algo::algorithm::detail::resize_and_fill( Output, Size,
+                        [&]( auto* Target )
+                        {
+                            ::string_algo::algorithm::detail::translate_copy_impl( Target, Data, Data+Size, From, To );
+                        } );
+                }
+                else
+                {
+                    Output=Input;
+                    ::string_algo::algorithm::detail::translate_impl( Output, From, To );
+                }
+
+                return Output;
+            }
+
+//  squeeze  ---------------------------------------------------------------//
+
+            // Selection of the members of a set to be removed by squeeze
+            /*
+                A member is removed, if it follows another member.
+            */
+            struct squeeze_members_selector
+            {
+                unsigned int m_Carry=0;
+
+                // Bit mask of the bytes of a block to be removed
+                unsigned int block( unsigned int Members )
+                {
+                    unsigned int Remove=Members & ( ( Members<<1 ) | m_Carry ) & 0xFFFF;
+                    m_Carry=( Members>>15 ) & 1;
+                    return Remove;
+                }
+
+                // Check if a single character should be removed
+                bool single( bool bMember )
+                {
+                    bool bRemove=bMember && m_Carry!=0;
+                    m_Carry=bMember ? 1 : 0;
+                    return bRemove;
+                }
+            };
+
+            // Squeeze [First,Last) to an output iterator
+            template< typename OutputIteratorT, typename InputIteratorT, typename PredicateT >
+            inline OutputIteratorT squeeze_generic(
+                OutputIteratorT Output,
+                InputIteratorT First,
+                InputIteratorT Last,
+                const PredicateT& Pred )
+            {
+                bool bPrev=false;
+                for( ; First!=Last; ++First )
+                {
+                    bool bMember=Pred(*First);
+                    if( !( bMember && bPrev ) )
+                    {
+                        *Output++=*First;
+                    }
+                    bPrev=bMember;
+                }
+                return Output;
+            }
+
+            // Squeeze [First,Last) to Output
+            /*
+                Output may be equal to First, or a distinct buffer with room
+                for the result.
+            */
+            template< typename CharT, typename PredicateT >
+            inline CharT* squeeze_compact(
+                const CharT* First,
+                const CharT* Last,
+                CharT* Output,
+                const PredicateT& Pred )
+            {
+                if constexpr( is_byte_char<CharT>::value )
+                {
+                    if( static_cast<std::size_t>(Last-First)>=erase_if_table_threshold )
+                    {
+                        byte_range_set Set=byte_range_set::template from_predicate<CharT>( Pred );
+                        if( Output==First )
+                        {
+                            return ::string_algo::algorithm::detail::compact_members(
+                                First, Last, Output, Set, squeeze_members_selector() );
+                        }
+                        return ::string_algo::algorithm::detail::copy_members(
+                            First, Last, Output, Set, squeeze_members_selector() );
+                    }
+                }
+
+                return ::string_algo::algorithm::detail::squeeze_generic( Output, First, Last, Pred );
+            }
+
+            // Copy [First,Last) to an output iterator, squeezing the runs of matching characters
+            template< typename OutputIteratorT, typename CharT, typename PredicateT >
+            inline OutputIteratorT squeeze_copy_impl(
+                OutputIteratorT Output,
+                const CharT* First,
+                const CharT* Last,
+                const PredicateT& Pred )
+            {
+                if constexpr( std::is_same_v<OutputIteratorT, std::remove_const_t<CharT>*> )
+                {
+                    return ::string_algo::algorithm::detail::squeeze_compact( First, Last, Output, Pred );
+                }
+                else
+                {
+                    return ::string_algo::algorithm::detail::squeeze_generic( Output, First, Last, Pred );
+                }
+            }
+
+            // In-place squeeze
+            template< typename SequenceT, typename PredicateT >
+            inline void squeeze_impl( SequenceT& Input, const PredicateT& Pred )
+            {
+                if constexpr( is_contiguous_sequence<SequenceT>::value )
+                {
+                    auto* Data=std::ranges::data(Input);
+                    std::size_t Size=std::ranges::size(Input);
+
+                    auto* End=::string_algo::algorithm::detail::squeeze_compact( Data, Data+Size, Data, Pred );
+                    Input.resize( static_cast<std::size_t>(End-Data) );
+                }
+                else
+                {
+                    Input.erase(
+                        ::string_algo::algorithm::detail::squeeze_generic(
+                            ::std::begin(Input), ::std::begin(Input), ::std::end(Input), Pred ),
+                        ::std::end(Input) );
+                }
+            }
+
+            // Copy variant of squeeze returning a sequence
+            template< typename SequenceT, typename PredicateT >
+            inline SequenceT squeeze_copy_impl( const SequenceT& Input, const PredicateT& Pred )
+            {
+                SequenceT Output;
+
+                if constexpr( is_contiguous_sequence<SequenceT>::value )
+                {
+                    const auto* Data=std::ranges::data(Input);
+                    std::size_t Size=std::ranges::size(Input);
+
+                    ::string_algo::algorithm::detail::resize_and_truncate( Output, Size,
+                        [&]( auto* Target )
+                        {
+                            return ::string_algo::algorithm::detail::squeeze_compact( Data, Data+Size, Target, Pred )-Target;
+                        } );
+                }
+                else
+                {
+                    ::string_algo::algorithm::detail::squeeze_generic(
+                        std::back_inserter(Output), ::std::begin(Input), ::std::end(Input), Pred );
+                }
+
+                return Output;
+            }
+
+        } // namespace detail
+    } // namespace algorithm
+} // namespace string_algo
+
+#endif  // STRING_TRANSLATE_DETAIL_HPP
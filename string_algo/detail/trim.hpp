@@ -3,7 +3,15 @@
 #ifndef STRING_TRIM_DETAIL_HPP
 #define STRING_TRIM_DETAIL_HPP
 
+#include <algorithm>
+#include <cstddef>
 #include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include "simd.hpp"
+
 namespace string_algo
 {
 	namespace algorithm
@@ -48,6 +56,95 @@ namespace string_algo
 
 				return InBegin;
 			}
+			//  contiguous byte trim -----------------------------------------------//
+
+			// Minimal length of a trimmed run, after which the predicate is tabulated
+			/*
+				Tabulation evaluates the predicate for all 256 byte values.
+				Shorter runs are scanned by the predicate directly.
+			*/
+			const std::size_t trim_table_threshold = 256;
+
+			// Check if an iterator addresses contiguous byte characters
+			template< typename IteratorT >
+			struct is_contiguous_byte_iterator :
+				std::bool_constant<
+					std::contiguous_iterator<IteratorT> &&
+					is_byte_char<std::iter_value_t<IteratorT> >::value> {};
+
+			// Search for first non matching character of a contiguous byte range
+			/*
+				Long runs of matching characters are skipped 16 bytes at a time
+				by the tabulated predicate. Predicates, which cannot be invoked
+				as const (e.g. mutable lambdas), are not tabulated.
+			*/
+			template< typename CharT, typename PredicateT >
+			inline const CharT* trim_begin_bytes(
+				const CharT* First,
+				const CharT* Last,
+				PredicateT& IsSpace)
+			{
+				typedef std::remove_const_t<CharT> char_type;
+
+				const CharT* Limit = Last;
+				if constexpr (std::is_invocable_v<const PredicateT&, char_type>)
+				{
+					Limit = First + std::min<std::ptrdiff_t>(Last - First, trim_table_threshold);
+				}
+
+				for (; First != Limit; ++First)
+				{
+					if (!IsSpace(*First))
+						return First;
+				}
+
+				if constexpr (std::is_invocable_v<const PredicateT&, char_type>)
+				{
+					if (First != Last)
+					{
+						return ::string_algo::algorithm::detail::find_first_not_of_ranges(
+							First, Last,
+							byte_range_set::template from_predicate<char_type>(std::as_const(IsSpace)));
+					}
+				}
+
+				return Last;
+			}
+
+			// Search for first non matching character of a contiguous byte range from the end
+			template< typename CharT, typename PredicateT >
+			inline const CharT* trim_end_bytes(
+				const CharT* First,
+				const CharT* Last,
+				PredicateT& IsSpace)
+			{
+				typedef std::remove_const_t<CharT> char_type;
+
+				const CharT* Limit = First;
+				if constexpr (std::is_invocable_v<const PredicateT&, char_type>)
+				{
+					Limit = Last - std::min<std::ptrdiff_t>(Last - First, trim_table_threshold);
+				}
+
+				for (; Last != Limit; --Last)
+				{
+					if (!IsSpace(Last[-1]))
+						return Last;
+				}
+
+				if constexpr (std::is_invocable_v<const PredicateT&, char_type>)
+				{
+					if (First != Last)
+					{
+						return ::string_algo::algorithm::detail::find_last_not_of_ranges(
+							First, Last,
+							byte_range_set::template from_predicate<char_type>(std::as_const(IsSpace)));
+					}
+				}
+
+				return First;
+			}
+
 			// Search for first non matching character from the beginning of the sequence
 			template< typename ForwardIteratorT, typename PredicateT >
 			inline ForwardIteratorT trim_begin(
@@ -55,14 +152,23 @@ namespace string_algo
 				ForwardIteratorT InEnd,
 				PredicateT IsSpace)
 			{
-				ForwardIteratorT It = InBegin;
-				for (; It != InEnd; ++It)
+				if constexpr (is_contiguous_byte_iterator<ForwardIteratorT>::value)
 				{
-					if (!IsSpace(*It))
-						return It;
+					const auto* First = std::to_address(InBegin);
+					return InBegin + (::string_algo::algorithm::detail::trim_begin_bytes(
+						First, First + (InEnd - InBegin), IsSpace) - First);
 				}
+				else
+				{
+					ForwardIteratorT It = InBegin;
+					for (; It != InEnd; ++It)
+					{
+						if (!IsSpace(*It))
+							return It;
+					}
 
-				return It;
+					return It;
+				}
 			}
 
 			// Search for first non matching character from the end of the sequence
@@ -72,9 +178,18 @@ namespace string_algo
 				ForwardIteratorT InEnd,
 				PredicateT IsSpace)
 			{
-				typedef typename std::iterator_traits<ForwardIteratorT>::iterator_category category;
+				if constexpr (is_contiguous_byte_iterator<ForwardIteratorT>::value)
+				{
+					const auto* First = std::to_address(InBegin);
+					return InBegin + (::string_algo::algorithm::detail::trim_end_bytes(
+						First, First + (InEnd - InBegin), IsSpace) - First);
+				}
+				else
+				{
+					typedef typename std::iterator_traits<ForwardIteratorT>::iterator_category category;
 
-				return algorithm::detail::trim_end_iter_select(InBegin, InEnd, IsSpace, category());
+					return algorithm::detail::trim_end_iter_select(InBegin, InEnd, IsSpace, category());
+				}
 			}
 
 		} // namespace detail
@@ -0,0 +1,129 @@
+
+#ifndef STRING_UTF8_DETAIL_HPP
+#define STRING_UTF8_DETAIL_HPP
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+#include "simd.hpp"
+
+namespace string_algo {
+    namespace algorithm {
+        namespace detail {
+
+//  UTF-8 codec  -------------------------------------------------------------//
+
+            // Number of bytes of the UTF-8 encoding of a code point
+            inline std::size_t utf8_length( std::uint32_t Code )
+            {
+                return Code<0x80 ? 1 : Code<0x800 ? 2 : Code<0x10000 ? 3 : 4;
+            }
+
+            // Encode a code point as UTF-8, returns the number of bytes written
+            template< typename CharT >
+            inline std::size_t encode_utf8( std::uint32_t Code, CharT* Output )
+            {
+                if( Code<0x80 )
+                {
+                    Output[0]=static_cast<CharT>( Code );
+                    return 1;
+                }
+                if( Code<0x800 )
+                {
+                    Output[0]=static_cast<CharT>( 0xC0 | ( Code>>6 ) );
+                    Output[1]=static_cast<CharT>( 0x80 | ( Code & 0x3F ) );
+                    return 2;
+                }
+                if( Code<0x10000 )
+                {
+                    Output[0]=static_cast<CharT>( 0xE0 | ( Code>>12 ) );
+                    Output[1]=static_cast<CharT>( 0x80 | ( ( Code>>6 ) & 0x3F ) );
+                    Output[2]=static_cast<CharT>( 0x80 | ( Code & 0x3F ) );
+                    return 3;
+                }
+                Output[0]=static_cast<CharT>( 0xF0 | ( Code>>18 ) );
+                Output[1]=static_cast<CharT>( 0x80 | ( ( Code>>12 ) & 0x3F ) );
+                Output[2]=static_cast<CharT>( 0x80 | ( ( Code>>6 ) & 0x3F ) );
+                Output[3]=static_cast<CharT>( 0x80 | ( Code & 0x3F ) );
+                return 4;
+            }
+
+            // Decode the UTF-8 sequence at First
+            /*
+                Returns the length of the sequence, or 0 if it is not a valid,
+                shortest form encoding of a scalar value.
+            */
+            template< typename CharT >
+            inline std::size_t decode_utf8( const CharT* First, const CharT* Last, std::uint32_t& Code )
+            {
+                std::uint32_t Lead=static_cast<unsigned char>( First[0] );
+                if( Lead<0x80 )
+                {
+                    Code=Lead;
+                    return 1;
+                }
+
+                std::size_t Size;
+                std::uint32_t Min;
+                if( Lead>=0xC2 && Lead<=0xDF ) { Size=2; Min=0x80; Code=Lead & 0x1F; }
+                else if( Lead>=0xE0 && Lead<=0xEF ) { Size=3; Min=0x800; Code=Lead & 0x0F; }
+                else if( Lead>=0xF0 && Lead<=0xF4 ) { Size=4; Min=0x10000; Code=Lead & 0x07; }
+                else return 0;
+
+                if( static_cast<std::size_t>( Last-First )<Size ) return 0;
+
+                for( std::size_t Index=1; Index<Size; ++Index )
+                {
+                    std::uint32_t Trail=static_cast<unsigned char>( First[Index] );
+                    if( ( Trail & 0xC0 )!=0x80 ) return 0;
+                    Code=( Code<<6 ) | ( Trail & 0x3F );
+                }
+
+                if( Code<Min || Code>0x10FFFF || ( Code>=0xD800 && Code<=0xDFFF ) ) return 0;
+                return Size;
+            }
+
+            // Find the first byte above 0x7F in [First,Last)
+            template< typename CharT >
+            inline const CharT* find_non_ascii( const CharT* First, const CharT* Last )
+            {
+#if defined(STRING_ALGO_SSE2)
+                for( ; Last-First>=16; First+=16 )
+                {
+                    unsigned int Mask=static_cast<unsigned int>(
+                        _mm_movemask_epi8( _mm_loadu_si128( reinterpret_cast<const __m128i*>(First) ) ) );
+                    if( Mask!=0 )
+                    {
+                        return First+std::countr_zero( Mask );
+                    }
+                }
+#endif
+                for( ; First!=Last; ++First )
+                {
+                    if( static_cast<unsigned char>(*First)>=0x80 ) return First;
+                }
+                return Last;
+            }
+
+            // Move a split point of a UTF-8 string back to the start of a sequence
+            /*
+                A sequence has at most three continuation bytes. If more precede
+                Split, no valid sequence spans it.
+            */
+            template< typename CharT >
+            inline const CharT* utf8_split_point( const CharT* First, const CharT* Split )
+            {
+                for( const CharT* It=Split; Split-It<=3; --It )
+                {
+                    if( ( static_cast<unsigned char>(*It) & 0xC0 )!=0x80 ) return It;
+                    if( It==First ) break;
+                }
+                return Split;
+            }
+
+        } // namespace detail
+    } // namespace algorithm
+} // namespace string_algo
+
+#endif  // STRING_UTF8_DETAIL_HPP
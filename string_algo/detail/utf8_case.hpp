@@ -0,0 +1,239 @@
+
+#ifndef STRING_UTF8_CASE_DETAIL_HPP
+#define STRING_UTF8_CASE_DETAIL_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+
+#include "case_conv.hpp"
+#include "sequence.hpp"
+#include "simd.hpp"
+#include "utf8.hpp"
+#include "utf8_case_table.hpp"
+
+namespace string_algo {
+    namespace algorithm {
+        namespace detail {
+
+//  UTF-8 case mapping  ------------------------------------------------------//
+
+            // Case mapping of utf8 algorithms
+            enum utf8_case_mode
+            {
+                utf8_lower,
+                utf8_upper,
+                utf8_fold
+            };
+
+            // Map a code point by the simple case mapping
+            template< utf8_case_mode Mode >
+            inline std::uint32_t utf8_case_map( std::uint32_t Code )
+            {
+                if( Code>=utf8_case_limit ) return Code;
+
+                const utf8_case_record& Record=utf8_case_records[
+                    utf8_case_stage2[
+                        ( static_cast<std::size_t>( utf8_case_stage1[Code>>utf8_case_shift] )<<utf8_case_shift ) |
+                        ( Code & ( ( 1u<<utf8_case_shift )-1 ) ) ] ];
+
+                std::int32_t Delta=( Mode==utf8_lower ) ? Record.Lower : ( Mode==utf8_upper ) ? Record.Upper : Record.Fold;
+                return static_cast<std::uint32_t>( static_cast<std::int32_t>(Code)+Delta );
+            }
+
+            // Convert the ASCII run at First
+            /*
+                Returns the end of the converted run, i.e. the first byte
+                above 0x7F or Last.
+            */
+            template< utf8_case_mode Mode, typename CharT >
+            inline const CharT* utf8_case_ascii_run( const CharT* First, const CharT* Last, CharT*& Output )
+            {
+#if defined(STRING_ALGO_SSE2)
+                for( ; Last-First>=16; First+=16, Output+=16 )
+                {
+                    __m128i Block=_mm_loadu_si128( reinterpret_cast<const __m128i*>(First) );
+                    if( _mm_movemask_epi8( Block )!=0 ) break;
+
+                    _mm_storeu_si128( reinterpret_cast<__m128i*>(Output), ascii_case_block<Mode==utf8_upper>( Block ) );
+                }
+#endif
+                const CharT* Run=::string_algo::algorithm::detail::find_non_ascii( First, Last );
+                ascii_case_bytes<Mode==utf8_upper>( First, Run, Output );
+                Output+=Run-First;
+                return Run;
+            }
+
+            // Size of the case mapping of a UTF-8 string
+            /*
+                bSameLength is set, if every character keeps the length of its
+                encoding, so that the string can be mapped in-place. Invalid
+                sequences are kept byte by byte.
+            */
+            template< utf8_case_mode Mode, typename CharT >
+            inline std::size_t utf8_case_size( const CharT* First, const CharT* Last, bool& bSameLength )
+            {
+                std::size_t Size=0;
+                bSameLength=true;
+
+                while( First!=Last )
+                {
+                    const CharT* Run=::string_algo::algorithm::detail::find_non_ascii( First, Last );
+                    Size+=static_cast<std::size_t>( Run-First );
+                    First=Run;
+                    if( First==Last ) break;
+
+                    std::uint32_t Code;
+                    std::size_t Length=::string_algo::algorithm::detail::decode_utf8( First, Last, Code );
+                    if( Length==0 )
+                    {
+                        ++Size;
+                        ++First;
+                        continue;
+                    }
+
+                    std::size_t MappedLength=::string_algo::algorithm::detail::utf8_length(
+                        ::string_algo::algorithm::detail::utf8_case_map<Mode>( Code ) );
+                    Size+=MappedLength;
+                    bSameLength=bSameLength && MappedLength==Length;
+                    First+=Length;
+                }
+
+                return Size;
+            }
+
+            // Case mapping of a UTF-8 string
+            /*
+                Output must have room for the size computed by utf8_case_size.
+                It may be equal to First, if the mapping keeps the lengths.
+                Returns the end of the output.
+            */
+            template< utf8_case_mode Mode, typename CharT >
+            inline CharT* utf8_case_write( const CharT* First, const CharT* Last, CharT* Output )
+            {
+                while( First!=Last )
+                {
+                    First=::string_algo::algorithm::detail::utf8_case_ascii_run<Mode>( First, Last, Output );
+                    if( First==Last ) break;
+
+                    std::uint32_t Code;
+                    std::size_t Length=::string_algo::algorithm::detail::decode_utf8( First, Last, Code );
+                    if( Length==0 )
+                    {
+                        *Output++=*First++;
+                        continue;
+                    }
+
+                    std::uint32_t Mapped=::string_algo::algorithm::detail::utf8_case_map<Mode>( Code );
+                    if( Mapped==Code )
+                    {
+                        Output=std::copy( First, First+Length, Output );
+                    }
+                    else
+                    {
+                        Output+=::string_algo::algorithm::detail::encode_utf8( Mapped, Output );
+                    }
+                    First+=Length;
+                }
+
+                return Output;
+            }
+
+            // Case mapping of a UTF-8 string to an output iterator
+            /*
+                Pointer outputs are written directly, other outputs receive
+                the result in chunks split at sequence boundaries. A mapped
+                encoding is at most 3/2 of the original.
+            */
+            template< utf8_case_mode Mode, typename OutputIteratorT, typename CharT >
+            inline OutputIteratorT utf8_case_copy(
+                OutputIteratorT Output,
+                const CharT* First,
+                const CharT* Last )
+            {
+                typedef std::remove_const_t<CharT> char_type;
+                static_assert( is_byte_char<char_type>::value, "UTF-8 requires a byte character type" );
+
+                if constexpr( std::is_same_v<OutputIteratorT, char_type*> )
+                {
+                    return ::string_algo::algorithm::detail::utf8_case_write<Mode>( First, Last, Output );
+                }
+                else
+                {
+                    const std::ptrdiff_t Chunk=256;
+                    char_type Buffer[Chunk*3/2];
+                    while( First!=Last )
+                    {
+                        const CharT* Next=Last;
+                        if( Last-First>Chunk )
+                        {
+                            Next=::string_algo::algorithm::detail::utf8_split_point( First, First+Chunk );
+                        }
+
+                        char_type* End=::string_algo::algorithm::detail::utf8_case_write<Mode>( First, Next, Buffer );
+                        Output=std::copy( Buffer, End, Output );
+                        First=Next;
+                    }
+                    return Output;
+                }
+            }
+
+            // Case mapping of a UTF-8 sequence
+            template< utf8_case_mode Mode, typename SequenceT >
+            inline SequenceT utf8_case_sequence_copy( const SequenceT& Input )
+            {
+                SequenceT Output;
+
+                const auto* Data=std::ranges::data(Input);
+                std::size_t Size=std::ranges::size(Input);
+
+                bool bSameLength;
+                std::size_t OutputSize=::string_algo::algorithm::detail::utf8_case_size<Mode>( Data, Data+Size, bSameLength );
+
+                ::string_algo::algorithm::detail::resize_and_fill( Output, OutputSize,
+                    [&]( auto* Target )
+                    {
+                        ::string_algo::algorithm::detail::utf8_case_write<Mode>( Data, Data+Size, Target );
+                    } );
+
+                return Output;
+            }
+
+            // In-place case mapping of a UTF-8 sequence
+            /*
+                The sequence is mapped in-place, if the lengths are kept.
+                Otherwise the result is built in a new sequence.
+            */
+            template< utf8_case_mode Mode, typename SequenceT >
+            inline void utf8_case_impl( SequenceT& Input )
+            {
+                auto* Data=std::ranges::data(Input);
+                std::size_t Size=std::ranges::size(Input);
+
+                bool bSameLength;
+                std::size_t OutputSize=::string_algo::algorithm::detail::utf8_case_size<Mode>( Data, Data+Size, bSameLength );
+
+                if( bSameLength )
+                {
+                    ::string_algo::algorithm::detail::utf8_case_write<Mode>( Data, Data+Size, Data );
+                }
+                else
+                {
+                    SequenceT Output;
+                    ::string_algo::algorithm::detail::resize_and_fill( Output, OutputSize,
+                        [&]( auto* Target )
+                        {
+                            ::string_algo::algorithm::detail::utf8_case_write<Mode>( Data, Data+Size, Target );
+                        } );
+                    Input=std::move( Output );
+                }
+            }
+
+        } // namespace detail
+    } // namespace algorithm
+} // namespace string_algo
+
+#endif  // STRING_UTF8_CASE_DETAIL_HPP
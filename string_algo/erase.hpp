@@ -0,0 +1,904 @@
+
+#ifndef STRING_ERASE_HPP
+#define STRING_ERASE_HPP
+
+#include <locale>
+
+#include "as_literal.hpp"
+#include "find_format.hpp"
+#include "finder.hpp"
+#include "formatter.hpp"
+#include "compare.hpp"
+#include "detail/erase.hpp"
+
+/*! \file
+    Defines various erase algorithms. Each algorithm removes
+    part(s) of the input according to a searching criteria.
+*/
+
+namespace string_algo {
+    namespace algorithm {
+
+//  erase_range -----------------------------------------------------------------------//
+
+        //! Erase range algorithm
+        /*!
+            Remove the given range from the input. The result is a modified copy of 
+            the input. It is returned as a sequence or copied to the output iterator.
+
+            \param Output An output iterator to which the result will be copied
+            \param Input An input string
+            \param SearchRange A range in the input to be removed
+            \return An output iterator pointing just after the last inserted character or
+                a modified copy of the input
+
+            \note The second variant of this function provides the strong exception-safety guarantee
+        */
+        template<
+            typename OutputIteratorT, 
+            typename Range1T>
+        inline OutputIteratorT erase_range_copy(
+            OutputIteratorT Output,
+            const Range1T& Input,
+            const std::span<
+               const std::remove_pointer_t<typename Range1T::pointer> >& SearchRange )
+        {
+            return ::string_algo::algorithm::find_format_copy(
+                Output,
+                Input,
+                ::string_algo::algorithm::range_finder(SearchRange),
+                ::string_algo::algorithm::empty_formatter(Input) );
+        }
+
+        //! Erase range algorithm
+        /*!
+            \overload
+        */
+        template<typename SequenceT>
+        inline SequenceT erase_range_copy( 
+            const SequenceT& Input,
+            const std::span<
+               const std::remove_pointer_t<typename SequenceT::pointer> >& SearchRange )
+        {
+            return ::string_algo::algorithm::find_format_copy(
+                Input,
+                ::string_algo::algorithm::range_finder(SearchRange),
+                ::string_algo::algorithm::empty_formatter(Input) );
+        }
+
+        //! Erase range algorithm
+        /*!
+            Remove the given range from the input.
+            The input sequence is modified in-place.
+
+            \param Input An input string
+            \param SearchRange A range in the input to be removed
+        */
+        template<typename SequenceT>
+        inline void erase_range( 
+            SequenceT& Input,
+            const std::span<
+               std::remove_pointer_t<typename SequenceT::pointer> >& SearchRange )
+        {
+            ::string_algo::algorithm::find_format(
+                Input,
+                ::string_algo::algorithm::range_finder(SearchRange),
+                ::string_algo::algorithm::empty_formatter(Input) );
+        }
+
+//  erase_first -----------------------------------------------------------------------//
+
+        //! Erase first algorithm
+        /*!
+            Remove the first occurrence of the substring from the input.
+            The result is a modified copy of the input. It is returned as a sequence 
+            or copied to the output iterator.
+
+            \param Output An output iterator to which the result will be copied
+            \param Input An input string
+            \param Search A substring to be searched for
+            \return An output iterator pointing just after the last inserted character or
+                a modified copy of the input
+
+            \note The second variant of this function provides the strong exception-safety guarantee
+        */
+        template<
+            typename OutputIteratorT, 
+            typename Range1T, 
+            typename Range2T>
+        inline OutputIteratorT erase_first_copy(
+            OutputIteratorT Output,
+            const Range1T& Input,
+            const Range2T& Search )
+        {
+            return ::string_algo::algorithm::find_format_copy(
+                Output,
+                Input,
+                ::string_algo::algorithm::first_finder(::string_algo::as_literal(Search)),
+                ::string_algo::algorithm::empty_formatter(Input) );
+        }
+
+        //! Erase first algorithm
+        /*!
+            \overload
+        */
+        template<typename SequenceT, typename RangeT>
+        inline SequenceT erase_first_copy( 
+            const SequenceT& Input,
+            const RangeT& Search )
+        {
+            return ::string_algo::algorithm::find_format_copy(
+                Input,
+                ::string_algo::algorithm::first_finder(::string_algo::as_literal(Search)),
+                ::string_algo::algorithm::empty_formatter(Input) );
+        }
+
+        //! Erase first algorithm
+        /*!
+            Remove the first occurrence of the substring from the input.
+            The input sequence is modified in-place.
+
+            \param Input An input string
+            \param Search A substring to be searched for
+        */
+        template<typename SequenceT, typename RangeT>
+        inline void erase_first( 
+            SequenceT& Input,
+            const RangeT& Search )
+        {
+            ::string_algo::algorithm::find_format(
+                Input,
+                ::string_algo::algorithm::first_finder(::string_algo::as_literal(Search)),
+                ::string_algo::algorithm::empty_formatter(Input) );
+        }
+
+//  erase_first ( case insensitive ) --------------------------------------------------//
+
+        //! Erase first algorithm ( case insensitive )
+        /*!
+            Remove the first occurrence of the substring from the input.
+            The result is a modified copy of the input. It is returned as a sequence 
+            or copied to the output iterator.
+            Searching is case insensitive.
+
+            \param Output An output iterator to which the result will be copied
+            \param Input An input string
+            \param Search A substring to be searched for
+            \param Loc A locale used for case insensitive comparison
+            \return An output iterator pointing just after the last inserted character or
+                a modified copy of the input
+
+            \note The second variant of this function provides the strong exception-safety guarantee
+        */
+        template<
+            typename OutputIteratorT, 
+            typename Range1T, 
+            typename Range2T>
+        inline OutputIteratorT ierase_first_copy(
+            OutputIteratorT Output,
+            const Range1T& Input,
+            const Range2T& Search,
+            const std::locale& Loc=std::locale() )
+        {
+            return ::string_algo::algorithm::find_format_copy(
+                Output,
+                Input,
+                ::string_algo::algorithm::first_finder(::string_algo::as_literal(Search), is_iequal(Loc)),
+                ::string_algo::algorithm::empty_formatter(Input) );
+        }
+
+        //! Erase first algorithm ( case insensitive )
+        /*!
+            \overload
+        */
+        template<typename SequenceT, typename RangeT>
+        inline SequenceT ierase_first_copy( 
+            const SequenceT& Input,
+            const RangeT& Search,
+            const std::locale& Loc=std::locale() )
+        {
+            return ::string_algo::algorithm::find_format_copy(
+                Input,
+                ::string_algo::algorithm::first_finder(::string_algo::as_literal(Search), is_iequal(Loc)),
+                ::string_algo::algorithm::empty_formatter(Input) );
+        }
+
+        //! Erase first algorithm ( case insensitive )
+        /*!
+            Remove the first occurrence of the substring from the input.
+            The input sequence is modified in-place.
+            Searching is case insensitive.
+
+            \param Input An input string
+            \param Search A substring to be searched for
+            \param Loc A locale used for case insensitive comparison
+        */
+        template<typename SequenceT, typename RangeT>
+        inline void ierase_first( 
+            SequenceT& Input,
+            const RangeT& Search,
+            const std::locale& Loc=std::locale() )
+        {
+            ::string_algo::algorithm::find_format(
+                Input,
+                ::string_algo::algorithm::first_finder(::string_algo::as_literal(Search), is_iequal(Loc)),
+                ::string_algo::algorithm::empty_formatter(Input) );
+        }
+
+//  erase_last ------------------------------------------------------------------------//
+
+        //! Erase last algorithm
+        /*!
+            Remove the last occurrence of the substring from the input.
+            The result is a modified copy of the input. It is returned as a sequence 
+            or copied to the output iterator.
+
+            \param Output An output iterator to which the result will be copied
+            \param Input An input string
+            \param Search A substring to be searched for
+            \return An output iterator pointing just after the last inserted character or
+                a modified copy of the input
+
+            \note The second variant of this function provides the strong exception-safety guarantee
+        */
+        template<
+            typename OutputIteratorT, 
+            typename Range1T, 
+            typename Range2T>
+        inline OutputIteratorT erase_last_copy(
+            OutputIteratorT Output,
+            const Range1T& Input,
+            const Range2T& Search )
+        {
+            return ::string_algo::algorithm::find_format_copy(
+                Output,
+                Input,
+                ::string_algo::algorithm::last_finder(::string_algo::as_literal(Search)),
+                ::string_algo::algorithm::empty_formatter(Input) );
+        }
+
+        //! Erase last algorithm
+        /*!
+            \overload
+        */
+        template<typename SequenceT, typename RangeT>
+        inline SequenceT erase_last_copy( 
+            const SequenceT& Input,
+            const RangeT& Search )
+        {
+            return ::string_algo::algorithm::find_format_copy(
+                Input,
+                ::string_algo::algorithm::last_finder(::string_algo::as_literal(Search)),
+                ::string_algo::algorithm::empty_formatter(Input) );
+        }
+
+        //! Erase last algorithm
+        /*!
+            Remove the last occurrence of the substring from the input.
+            The input sequence is modified in-place.
+
+            \param Input An input string
+            \param Search A substring to be searched for
+        */
+        template<typename SequenceT, typename RangeT>
+        inline void erase_last( 
+            SequenceT& Input,
+            const RangeT& Search )
+        {
+            ::string_algo::algorithm::find_format(
+                Input,
+                ::string_algo::algorithm::last_finder(::string_algo::as_literal(Search)),
+                ::string_algo::algorithm::empty_formatter(Input) );
+        }
+
+//  erase_last ( case insensitive ) ---------------------------------------------------//
+
+        //! Erase last algorithm ( case insensitive )
+        /*!
+            Remove the last occurrence of the substring from the input.
+            The result is a modified copy of the input. It is returned as a sequence 
+            or copied to the output iterator.
+            Searching is case insensitive.
+
+            \param Output An output iterator to which the result will be copied
+            \param Input An input string
+            \param Search A substring to be searched for
+            \param Loc A locale used for case insensitive comparison
+            \return An output iterator pointing just after the last inserted character or
+                a modified copy of the input
+
+            \note The second variant of this function provides the strong exception-safety guarantee
+        */
+        template<
+            typename OutputIteratorT, 
+            typename Range1T, 
+            typename Range2T>
+        inline OutputIteratorT ierase_last_copy(
+            OutputIteratorT Output,
+            const Range1T& Input,
+            const Range2T& Search,
+            const std::locale& Loc=std::locale() )
+        {
+            return ::string_algo::algorithm::find_format_copy(
+                Output,
+                Input,
+                ::string_algo::algorithm::last_finder(::string_algo::as_literal(Search), is_iequal(Loc)),
+                ::string_algo::algorithm::empty_formatter(Input) );
+        }
+
+        //! Erase last algorithm ( case insensitive )
+        /*!
+            \overload
+        */
+        template<typename SequenceT, typename RangeT>
+        inline SequenceT ierase_last_copy( 
+            const SequenceT& Input,
+            const RangeT& Search,
+            const std::locale& Loc=std::locale() )
+        {
+            return ::string_algo::algorithm::find_format_copy(
+                Input,
+                ::string_algo::algorithm::last_finder(::string_algo::as_literal(Search), is_iequal(Loc)),
+                ::string_algo::algorithm::empty_formatter(Input) );
+        }
+
+        //! Erase last algorithm ( case insensitive )
+        /*!
+            Remove the last occurrence of the substring from the input.
+            The input sequence is modified in-place.
+            Searching is case insensitive.
+
+            \param Input An input string
+            \param Search A substring to be searched for
+            \param Loc A locale used for case insensitive comparison
+        */
+        template<typename SequenceT, typename RangeT>
+        inline void ierase_last( 
+            SequenceT& Input,
+            const RangeT& Search,
+            const std::locale& Loc=std::locale() )
+        {
+            ::string_algo::algorithm::find_format(
+                Input,
+                ::string_algo::algorithm::last_finder(::string_algo::as_literal(Search), is_iequal(Loc)),
+                ::string_algo::algorithm::empty_formatter(Input) );
+        }
+
+//  erase_nth -------------------------------------------------------------------------//
+
+        //! Erase nth algorithm
+        /*!
+            Remove the Nth occurrence of the substring in the input.
+            The result is a modified copy of the input. It is returned as a sequence 
+            or copied to the output iterator.
+
+            \param Output An output iterator to which the result will be copied
+            \param Input An input string
+            \param Search A substring to be searched for
+            \param Nth An index of the match to be replaced. The index is 0-based.
+                For negative N, matches are counted from the end of string.
+            \return An output iterator pointing just after the last inserted character or
+                a modified copy of the input
+
+            \note The second variant of this function provides the strong exception-safety guarantee
+        */
+        template<
+            typename OutputIteratorT, 
+            typename Range1T, 
+            typename Range2T>
+        inline OutputIteratorT erase_nth_copy(
+            OutputIteratorT Output,
+            const Range1T& Input,
+            const Range2T& Search,
+            int Nth )
+        {
+            return ::string_algo::algorithm::find_format_copy(
+                Output,
+                Input,
+                ::string_algo::algorithm::nth_finder(::string_algo::as_literal(Search), Nth),
+                ::string_algo::algorithm::empty_formatter(Input) );
+        }
+
+        //! Erase nth algorithm
+        /*!
+            \overload
+        */
+        template<typename SequenceT, typename RangeT>
+        inline SequenceT erase_nth_copy( 
+            const SequenceT& Input,
+            const RangeT& Search,
+            int Nth )
+        {
+            return ::string_algo::algorithm::find_format_copy(
+                Input,
+                ::string_algo::algorithm::nth_finder(::string_algo::as_literal(Search), Nth),
+                ::string_algo::algorithm::empty_formatter(Input) );
+        }
+
+        //! Erase nth algorithm
+        /*!
+            Remove the Nth occurrence of the substring in the input.
+            The input sequence is modified in-place.
+
+            \param Input An input string
+            \param Search A substring to be searched for
+            \param Nth An index of the match to be replaced. The index is 0-based.
+                For negative N, matches are counted from the end of string.
+        */
+        template<typename SequenceT, typename RangeT>
+        inline void erase_nth( 
+            SequenceT& Input,
+            const RangeT& Search,
+            int Nth )
+        {
+            ::string_algo::algorithm::find_format(
+                Input,
+                ::string_algo::algorithm::nth_finder(::string_algo::as_literal(Search), Nth),
+                ::string_algo::algorithm::empty_formatter(Input) );
+        }
+
+//  erase_nth ( case insensitive ) ----------------------------------------------------//
+
+        //! Erase nth algorithm ( case insensitive )
+        /*!
+            Remove the Nth occurrence of the substring in the input.
+            The result is a modified copy of the input. It is returned as a sequence 
+            or copied to the output iterator.
+            Searching is case insensitive.
+
+            \param Output An output iterator to which the result will be copied
+            \param Input An input string
+            \param Search A substring to be searched for
+            \param Nth An index of the match to be replaced. The index is 0-based.
+                For negative N, matches are counted from the end of string.
+            \param Loc A locale used for case insensitive comparison
+            \return An output iterator pointing just after the last inserted character or
+                a modified copy of the input
+
+            \note The second variant of this function provides the strong exception-safety guarantee
+        */
+        template<
+            typename OutputIteratorT, 
+            typename Range1T, 
+            typename Range2T>
+        inline OutputIteratorT ierase_nth_copy(
+            OutputIteratorT Output,
+            const Range1T& Input,
+            const Range2T& Search,
+            int Nth,
+            const std::locale& Loc=std::locale() )
+        {
+            return ::string_algo::algorithm::find_format_copy(
+                Output,
+                Input,
+                ::string_algo::algorithm::nth_finder(::string_algo::as_literal(Search), Nth, is_iequal(Loc)),
+                ::string_algo::algorithm::empty_formatter(Input) );
+        }
+
+        //! Erase nth algorithm ( case insensitive )
+        /*!
+            \overload
+        */
+        template<typename SequenceT, typename RangeT>
+        inline SequenceT ierase_nth_copy( 
+            const SequenceT& Input,
+            const RangeT& Search,
+            int Nth,
+            const std::locale& Loc=std::locale() )
+        {
+            return ::string_algo::algorithm::find_format_copy(
+                Input,
+                ::string_algo::algorithm::nth_finder(::string_algo::as_literal(Search), Nth, is_iequal(Loc)),
+                ::string_algo::algorithm::empty_formatter(Input) );
+        }
+
+        //! Erase nth algorithm ( case insensitive )
+        /*!
+            Remove the Nth occurrence of the substring in the input.
+            The input sequence is modified in-place.
+            Searching is case insensitive.
+
+            \param Input An input string
+            \param Search A substring to be searched for
+            \param Nth An index of the match to be replaced. The index is 0-based.
+                For negative N, matches are counted from the end of string.
+            \param Loc A locale used for case insensitive comparison
+        */
+        template<typename SequenceT, typename RangeT>
+        inline void ierase_nth( 
+            SequenceT& Input,
+            const RangeT& Search,
+            int Nth,
+            const std::locale& Loc=std::locale() )
+        {
+            ::string_algo::algorithm::find_format(
+                Input,
+                ::string_algo::algorithm::nth_finder(::string_algo::as_literal(Search), Nth, is_iequal(Loc)),
+                ::string_algo::algorithm::empty_formatter(Input) );
+        }
+
+//  erase_all -------------------------------------------------------------------------//
+
+        //! Erase all algorithm
+        /*!
+            Remove all the occurrences of the string from the input.
+            The result is a modified copy of the input. It is returned as a sequence 
+            or copied to the output iterator.
+
+            \param Output An output iterator to which the result will be copied
+            \param Input An input string
+            \param Search A substring to be searched for
+            \return An output iterator pointing just after the last inserted character or
+                a modified copy of the input
+
+            \note The second variant of this function provides the strong exception-safety guarantee
+        */
+        template<
+            typename OutputIteratorT, 
+            typename Range1T, 
+            typename Range2T>
+        inline OutputIteratorT erase_all_copy(
+            OutputIteratorT Output,
+            const Range1T& Input,
+            const Range2T& Search )
+        {
+            return ::string_algo::algorithm::find_format_all_copy(
+                Output,
+                Input,
+                ::string_algo::algorithm::first_finder(::string_algo::as_literal(Search)),
+                ::string_algo::algorithm::empty_formatter(Input) );
+        }
+
+        //! Erase all algorithm
+        /*!
+            \overload
+        */
+        template<typename SequenceT, typename RangeT>
+        inline SequenceT erase_all_copy( 
+            const SequenceT& Input,
+            const RangeT& Search )
+        {
+            return ::string_algo::algorithm::find_format_all_copy(
+                Input,
+                ::string_algo::algorithm::first_finder(::string_algo::as_literal(Search)),
+                ::string_algo::algorithm::empty_formatter(Input) );
+        }
+
+        //! Erase all algorithm
+        /*!
+            Remove all the occurrences of the string from the input.
+            The input sequence is modified in-place. Contiguous sequences
+            are compacted in a single forward pass.
+
+            \param Input An input string
+            \param Search A substring to be searched for
+        */
+        template<typename SequenceT, typename RangeT>
+        inline void erase_all( 
+            SequenceT& Input,
+            const RangeT& Search )
+        {
+            ::string_algo::algorithm::find_format_all(
+                Input,
+                ::string_algo::algorithm::first_finder(::string_algo::as_literal(Search)),
+                ::string_algo::algorithm::empty_formatter(Input) );
+        }
+
+//  erase_all ( case insensitive ) ----------------------------------------------------//
+
+        //! Erase all algorithm ( case insensitive )
+        /*!
+            Remove all the occurrences of the string from the input.
+            The result is a modified copy of the input. It is returned as a sequence 
+            or copied to the output iterator.
+            Searching is case insensitive.
+
+            \param Output An output iterator to which the result will be copied
+            \param Input An input string
+            \param Search A substring to be searched for
+            \param Loc A locale used for case insensitive comparison
+            \return An output iterator pointing just after the last inserted character or
+                a modified copy of the input
+
+            \note The second variant of this function provides the strong exception-safety guarantee
+        */
+        template<
+            typename OutputIteratorT, 
+            typename Range1T, 
+            typename Range2T>
+        inline OutputIteratorT ierase_all_copy(
+            OutputIteratorT Output,
+            const Range1T& Input,
+            const Range2T& Search,
+            const std::locale& Loc=std::locale() )
+        {
+            return ::string_algo::algorithm::find_format_all_copy(
+                Output,
+                Input,
+                ::string_algo::algorithm::first_finder(::string_algo::as_literal(Search), is_iequal(Loc)),
+                ::string_algo::algorithm::empty_formatter(Input) );
+        }
+
+        //! Erase all algorithm ( case insensitive )
+        /*!
+            \overload
+        */
+        template<typename SequenceT, typename RangeT>
+        inline SequenceT ierase_all_copy( 
+            const SequenceT& Input,
+            const RangeT& Search,
+            const std::locale& Loc=std::locale() )
+        {
+            return ::string_algo::algorithm::find_format_all_copy(
+                Input,
+                ::string_algo::algorithm::first_finder(::string_algo::as_literal(Search), is_iequal(Loc)),
+                ::string_algo::algorithm::empty_formatter(Input) );
+        }
+
+        //! Erase all algorithm ( case insensitive )
+        /*!
+            Remove all the occurrences of the string from the input.
+            The input sequence is modified in-place.
+            Searching is case insensitive.
+
+            \param Input An input string
+            \param Search A substring to be searched for
+            \param Loc A locale used for case insensitive comparison
+        */
+        template<typename SequenceT, typename RangeT>
+        inline void ierase_all( 
+            SequenceT& Input,
+            const RangeT& Search,
+            const std::locale& Loc=std::locale() )
+        {
+            ::string_algo::algorithm::find_format_all(
+                Input,
+                ::string_algo::algorithm::first_finder(::string_algo::as_literal(Search), is_iequal(Loc)),
+                ::string_algo::algorithm::empty_formatter(Input) );
+        }
+
+//  erase_head ------------------------------------------------------------------------//
+
+        //! Erase head algorithm
+        /*!
+            Remove the head from the input. The head is a prefix of a sequence of given size. 
+            If the sequence is shorter then required, the whole string is 
+            considered to be the head. The result is a modified copy of the input. 
+            It is returned as a sequence or copied to the output iterator.
+
+            \param Output An output iterator to which the result will be copied
+            \param Input An input string
+            \param N Length of the head.
+                For N>=0, at most N characters are extracted.
+                For N<0, size(Input)-|N| characters are extracted.
+            \return An output iterator pointing just after the last inserted character or
+                a modified copy of the input
+
+            \note The second variant of this function provides the strong exception-safety guarantee
+        */
+        template<
+            typename OutputIteratorT, 
+            typename Range1T>
+        inline OutputIteratorT erase_head_copy(
+            OutputIteratorT Output,
+            const Range1T& Input,
+            int N )
+        {
+            return ::string_algo::algorithm::find_format_copy(
+                Output,
+                Input,
+                ::string_algo::algorithm::head_finder(N),
+                ::string_algo::algorithm::empty_formatter(Input) );
+        }
+
+        //! Erase head algorithm
+        /*!
+            \overload
+        */
+        template<typename SequenceT>
+        inline SequenceT erase_head_copy( 
+            const SequenceT& Input,
+            int N )
+        {
+            return ::string_algo::algorithm::find_format_copy(
+                Input,
+                ::string_algo::algorithm::head_finder(N),
+                ::string_algo::algorithm::empty_formatter(Input) );
+        }
+
+        //! Erase head algorithm
+        /*!
+            Remove the head from the input. The head is a prefix of a sequence of given size. 
+            If the sequence is shorter then required, the whole string is 
+            considered to be the head. The input sequence is modified in-place.
+
+            \param Input An input string
+            \param N Length of the head.
+                For N>=0, at most N characters are extracted.
+                For N<0, size(Input)-|N| characters are extracted.
+        */
+        template<typename SequenceT>
+        inline void erase_head( 
+            SequenceT& Input,
+            int N )
+        {
+            ::string_algo::algorithm::find_format(
+                Input,
+                ::string_algo::algorithm::head_finder(N),
+                ::string_algo::algorithm::empty_formatter(Input) );
+        }
+
+//  erase_tail ------------------------------------------------------------------------//
+
+        //! Erase tail algorithm
+        /*!
+            Remove the tail from the input. The tail is a suffix of a sequence of given size. 
+            If the sequence is shorter then required, the whole string is 
+            considered to be the tail. The result is a modified copy of the input. 
+            It is returned as a sequence or copied to the output iterator.
+
+            \param Output An output iterator to which the result will be copied
+            \param Input An input string
+            \param N Length of the tail.
+                For N>=0, at most N characters are extracted.
+                For N<0, size(Input)-|N| characters are extracted.
+            \return An output iterator pointing just after the last inserted character or
+                a modified copy of the input
+
+            \note The second variant of this function provides the strong exception-safety guarantee
+        */
+        template<
+            typename OutputIteratorT, 
+            typename Range1T>
+        inline OutputIteratorT erase_tail_copy(
+            OutputIteratorT Output,
+            const Range1T& Input,
+            int N )
+        {
+            return ::string_algo::algorithm::find_format_copy(
+                Output,
+                Input,
+                ::string_algo::algorithm::tail_finder(N),
+                ::string_algo::algorithm::empty_formatter(Input) );
+        }
+
+        //! Erase tail algorithm
+        /*!
+            \overload
+        */
+        template<typename SequenceT>
+        inline SequenceT erase_tail_copy( 
+            const SequenceT& Input,
+            int N )
+        {
+            return ::string_algo::algorithm::find_format_copy(
+                Input,
+                ::string_algo::algorithm::tail_finder(N),
+                ::string_algo::algorithm::empty_formatter(Input) );
+        }
+
+        //! Erase tail algorithm
+        /*!
+            Remove the tail from the input. The tail is a suffix of a sequence of given size. 
+            If the sequence is shorter then required, the whole string is 
+            considered to be the tail. The input sequence is modified in-place.
+
+            \param Input An input string
+            \param N Length of the tail.
+                For N>=0, at most N characters are extracted.
+                For N<0, size(Input)-|N| characters are extracted.
+        */
+        template<typename SequenceT>
+        inline void erase_tail( 
+            SequenceT& Input,
+            int N )
+        {
+            ::string_algo::algorithm::find_format(
+                Input,
+                ::string_algo::algorithm::tail_finder(N),
+                ::string_algo::algorithm::empty_formatter(Input) );
+        }
+
+//  erase_if --------------------------------------------------------------------------//
+
+        //! Erase if algorithm
+        /*!
+            Remove all characters satisfying the predicate from the input.
+            The result is a modified copy of the input. It is returned as a sequence 
+            or copied to the output iterator.
+
+            For byte character types and inputs of at least a few hundred characters,
+            the predicate is evaluated once for every byte value and the input is
+            filtered using the resulting table. Sets consisting of a few ranges
+            of characters, like \c is_any_of("\"'") or \c is_cntrl(), are matched
+            16 bytes at a time. The predicate must depend only on its argument.
+
+            \param Output An output iterator to which the result will be copied
+            \param Input An input string
+            \param Pred A predicate selecting the characters to be removed
+            \return An output iterator pointing just after the last inserted character or
+                a modified copy of the input
+        */
+        template<
+            typename OutputIteratorT,
+            typename RangeT,
+            typename PredicateT>
+        inline OutputIteratorT erase_if_copy(
+            OutputIteratorT Output,
+            const RangeT& Input,
+            PredicateT Pred )
+        {
+            auto lit_input=::string_algo::as_literal(Input);
+
+            return ::string_algo::algorithm::detail::erase_if_copy_impl(
+                Output,
+                lit_input.data(),
+                lit_input.data()+lit_input.size(),
+                Pred );
+        }
+
+        //! Erase if algorithm
+        /*!
+            \overload
+        */
+        template<typename SequenceT, typename PredicateT>
+        inline SequenceT erase_if_copy( 
+            const SequenceT& Input,
+            PredicateT Pred )
+        {
+            return ::string_algo::algorithm::detail::erase_if_copy_impl( Input, Pred );
+        }
+
+        //! Erase if algorithm
+        /*!
+            Remove all characters satisfying the predicate from the input.
+            The input sequence is modified in-place. Contiguous sequences
+            are compacted in a single forward pass.
+
+            \param Input An input string
+            \param Pred A predicate selecting the characters to be removed
+
+            \note An unqualified call with a \c std::basic_string argument selects
+                \c std::erase_if, which is found by argument dependent lookup.
+                Call \c string_algo::erase_if explicitly to use this algorithm.
+        */
+        template<typename SequenceT, typename PredicateT>
+        inline void erase_if( 
+            SequenceT& Input,
+            PredicateT Pred )
+        {
+            ::string_algo::algorithm::detail::erase_if_impl( Input, Pred );
+        }
+
+    } // namespace algorithm
+
+    // pull names to the boost namespace
+    using algorithm::erase_range_copy;
+    using algorithm::erase_range;
+    using algorithm::erase_first_copy;
+    using algorithm::erase_first;
+    using algorithm::ierase_first_copy;
+    using algorithm::ierase_first;
+    using algorithm::erase_last_copy;
+    using algorithm::erase_last;
+    using algorithm::ierase_last_copy;
+    using algorithm::ierase_last;
+    using algorithm::erase_nth_copy;
+    using algorithm::erase_nth;
+    using algorithm::ierase_nth_copy;
+    using algorithm::ierase_nth;
+    using algorithm::erase_all_copy;
+    using algorithm::erase_all;
+    using algorithm::ierase_all_copy;
+    using algorithm::ierase_all;
+    using algorithm::erase_head_copy;
+    using algorithm::erase_head;
+    using algorithm::erase_tail_copy;
+    using algorithm::erase_tail;
+    using algorithm::erase_if_copy;
+    using algorithm::erase_if;
+
+} // namespace string_algo
+
+
+#endif  // STRING_ERASE_HPP
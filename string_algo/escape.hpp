@@ -0,0 +1,527 @@
+
+#ifndef STRING_ESCAPE_HPP
+#define STRING_ESCAPE_HPP
+
+#include "find_format.hpp"
+#include "detail/escape.hpp"
+
+/*! \file
+	Defines escape and unescape algorithms for JSON strings, HTML text and URL
+	percent-encoding. They work on byte (UTF-8) strings.
+
+	Each encoding is provided as a finder and formatter pair, used by the
+	find_format_all algorithms. Characters to be escaped are located by a vector
+	scan and the clean runs between them are copied as blocks. The formatters
+	write the escape sequences directly to the output and report their size,
+	so the result is allocated once with its exact size.
+*/
+
+namespace string_algo {
+	namespace algorithm {
+
+		//  json_escape  -----------------------------------------------//
+
+		//! JSON string escape finder
+		/*!
+			Construct the finder of runs of characters, which are escaped
+			by the JSON string escape.
+
+			\return An instance of the \c escape_finder object
+		*/
+		inline detail::escape_finderF json_escape_finder()
+		{
+			return detail::escape_finderF(detail::json_escape_table());
+		}
+
+		//! JSON string escape formatter
+		/*!
+			Construct the formatter, which writes the JSON string escape sequences
+			of the characters of a match.
+
+			\return An instance of the \c escape_formatter object
+		*/
+		inline detail::escape_formatF json_escape_formatter()
+		{
+			return detail::escape_formatF(detail::json_escape_table());
+		}
+
+		//! JSON string escape algorithm
+		/*!
+			Quotation marks, reverse solidi and control characters are escaped,
+			as required for the contents of a JSON string. Other characters, including
+			UTF-8 sequences, are kept.
+			The result is a modified copy of the input. It is returned as a sequence
+			or copied to the output iterator.
+
+			\param Output An output iterator to which the result will be copied
+			\param Input An input string
+			\return An output iterator pointing just after the last inserted character or
+				a modified copy of the input
+		*/
+		template<typename OutputIteratorT, typename RangeT>
+		inline OutputIteratorT json_escape_copy(
+			OutputIteratorT Output,
+			const RangeT& Input)
+		{
+			return ::string_algo::algorithm::find_format_all_copy(
+				Output,
+				Input,
+				::string_algo::algorithm::json_escape_finder(),
+				::string_algo::algorithm::json_escape_formatter());
+		}
+
+		//! JSON string escape algorithm
+		/*!
+			\overload
+		*/
+		template<typename SequenceT>
+		inline SequenceT json_escape_copy(const SequenceT& Input)
+		{
+			return ::string_algo::algorithm::find_format_all_copy(
+				Input,
+				::string_algo::algorithm::json_escape_finder(),
+				::string_algo::algorithm::json_escape_formatter());
+		}
+
+		//! JSON string escape algorithm
+		/*!
+			Quotation marks, reverse solidi and control characters are escaped,
+			as required for the contents of a JSON string. Other characters, including
+			UTF-8 sequences, are kept.
+			The input sequence is modified in-place.
+
+			\param Input An input string
+		*/
+		template<typename SequenceT>
+		inline void json_escape(SequenceT& Input)
+		{
+			::string_algo::algorithm::find_format_all(
+				Input,
+				::string_algo::algorithm::json_escape_finder(),
+				::string_algo::algorithm::json_escape_formatter());
+		}
+
+		//  json_unescape  ---------------------------------------------//
+
+		//! JSON string unescape finder
+		/*!
+			Construct the finder of well formed JSON string escape sequences.
+
+			\return An instance of the \c unescape_finder object
+		*/
+		inline detail::unescape_finderF<detail::json_decoder> json_unescape_finder()
+		{
+			return detail::unescape_finderF<detail::json_decoder>();
+		}
+
+		//! JSON string unescape formatter
+		/*!
+			Construct the formatter, which writes the decoded JSON string escape sequence.
+
+			\return An instance of the \c unescape_formatter object
+		*/
+		inline detail::unescape_formatF<detail::json_decoder> json_unescape_formatter()
+		{
+			return detail::unescape_formatF<detail::json_decoder>();
+		}
+
+		//! JSON string unescape algorithm
+		/*!
+			The short escapes and \\uXXXX sequences are decoded, the latter to UTF-8.
+			Surrogate pairs are combined. Malformed sequences are kept as they are.
+			The result is a modified copy of the input. It is returned as a sequence
+			or copied to the output iterator.
+
+			\param Output An output iterator to which the result will be copied
+			\param Input An input string
+			\return An output iterator pointing just after the last inserted character or
+				a modified copy of the input
+		*/
+		template<typename OutputIteratorT, typename RangeT>
+		inline OutputIteratorT json_unescape_copy(
+			OutputIteratorT Output,
+			const RangeT& Input)
+		{
+			return ::string_algo::algorithm::find_format_all_copy(
+				Output,
+				Input,
+				::string_algo::algorithm::json_unescape_finder(),
+				::string_algo::algorithm::json_unescape_formatter());
+		}
+
+		//! JSON string unescape algorithm
+		/*!
+			\overload
+		*/
+		template<typename SequenceT>
+		inline SequenceT json_unescape_copy(const SequenceT& Input)
+		{
+			return ::string_algo::algorithm::find_format_all_copy(
+				Input,
+				::string_algo::algorithm::json_unescape_finder(),
+				::string_algo::algorithm::json_unescape_formatter());
+		}
+
+		//! JSON string unescape algorithm
+		/*!
+			The short escapes and \\uXXXX sequences are decoded, the latter to UTF-8.
+			Surrogate pairs are combined. Malformed sequences are kept as they are.
+			The input sequence is modified in-place.
+
+			\param Input An input string
+		*/
+		template<typename SequenceT>
+		inline void json_unescape(SequenceT& Input)
+		{
+			::string_algo::algorithm::find_format_all(
+				Input,
+				::string_algo::algorithm::json_unescape_finder(),
+				::string_algo::algorithm::json_unescape_formatter());
+		}
+
+		//  html_escape  -----------------------------------------------//
+
+		//! HTML escape finder
+		/*!
+			Construct the finder of runs of characters, which are escaped
+			by the HTML escape.
+
+			\return An instance of the \c escape_finder object
+		*/
+		inline detail::escape_finderF html_escape_finder()
+		{
+			return detail::escape_finderF(detail::html_escape_table());
+		}
+
+		//! HTML escape formatter
+		/*!
+			Construct the formatter, which writes the HTML escape sequences
+			of the characters of a match.
+
+			\return An instance of the \c escape_formatter object
+		*/
+		inline detail::escape_formatF html_escape_formatter()
+		{
+			return detail::escape_formatF(detail::html_escape_table());
+		}
+
+		//! HTML escape algorithm
+		/*!
+			The characters &, <, >, " and ' are replaced by character references.
+			The result is a modified copy of the input. It is returned as a sequence
+			or copied to the output iterator.
+
+			\param Output An output iterator to which the result will be copied
+			\param Input An input string
+			\return An output iterator pointing just after the last inserted character or
+				a modified copy of the input
+		*/
+		template<typename OutputIteratorT, typename RangeT>
+		inline OutputIteratorT html_escape_copy(
+			OutputIteratorT Output,
+			const RangeT& Input)
+		{
+			return ::string_algo::algorithm::find_format_all_copy(
+				Output,
+				Input,
+				::string_algo::algorithm::html_escape_finder(),
+				::string_algo::algorithm::html_escape_formatter());
+		}
+
+		//! HTML escape algorithm
+		/*!
+			\overload
+		*/
+		template<typename SequenceT>
+		inline SequenceT html_escape_copy(const SequenceT& Input)
+		{
+			return ::string_algo::algorithm::find_format_all_copy(
+				Input,
+				::string_algo::algorithm::html_escape_finder(),
+				::string_algo::algorithm::html_escape_formatter());
+		}
+
+		//! HTML escape algorithm
+		/*!
+			The characters &, <, >, " and ' are replaced by character references.
+			The input sequence is modified in-place.
+
+			\param Input An input string
+		*/
+		template<typename SequenceT>
+		inline void html_escape(SequenceT& Input)
+		{
+			::string_algo::algorithm::find_format_all(
+				Input,
+				::string_algo::algorithm::html_escape_finder(),
+				::string_algo::algorithm::html_escape_formatter());
+		}
+
+		//  html_unescape  ---------------------------------------------//
+
+		//! HTML unescape finder
+		/*!
+			Construct the finder of well formed HTML escape sequences.
+
+			\return An instance of the \c unescape_finder object
+		*/
+		inline detail::unescape_finderF<detail::html_decoder> html_unescape_finder()
+		{
+			return detail::unescape_finderF<detail::html_decoder>();
+		}
+
+		//! HTML unescape formatter
+		/*!
+			Construct the formatter, which writes the decoded HTML escape sequence.
+
+			\return An instance of the \c unescape_formatter object
+		*/
+		inline detail::unescape_formatF<detail::html_decoder> html_unescape_formatter()
+		{
+			return detail::unescape_formatF<detail::html_decoder>();
+		}
+
+		//! HTML unescape algorithm
+		/*!
+			The references amp, lt, gt, quot, apos and numeric character references
+			are decoded, the latter to UTF-8. Other references are kept as they are.
+			The result is a modified copy of the input. It is returned as a sequence
+			or copied to the output iterator.
+
+			\param Output An output iterator to which the result will be copied
+			\param Input An input string
+			\return An output iterator pointing just after the last inserted character or
+				a modified copy of the input
+		*/
+		template<typename OutputIteratorT, typename RangeT>
+		inline OutputIteratorT html_unescape_copy(
+			OutputIteratorT Output,
+			const RangeT& Input)
+		{
+			return ::string_algo::algorithm::find_format_all_copy(
+				Output,
+				Input,
+				::string_algo::algorithm::html_unescape_finder(),
+				::string_algo::algorithm::html_unescape_formatter());
+		}
+
+		//! HTML unescape algorithm
+		/*!
+			\overload
+		*/
+		template<typename SequenceT>
+		inline SequenceT html_unescape_copy(const SequenceT& Input)
+		{
+			return ::string_algo::algorithm::find_format_all_copy(
+				Input,
+				::string_algo::algorithm::html_unescape_finder(),
+				::string_algo::algorithm::html_unescape_formatter());
+		}
+
+		//! HTML unescape algorithm
+		/*!
+			The references amp, lt, gt, quot, apos and numeric character references
+			are decoded, the latter to UTF-8. Other references are kept as they are.
+			The input sequence is modified in-place.
+
+			\param Input An input string
+		*/
+		template<typename SequenceT>
+		inline void html_unescape(SequenceT& Input)
+		{
+			::string_algo::algorithm::find_format_all(
+				Input,
+				::string_algo::algorithm::html_unescape_finder(),
+				::string_algo::algorithm::html_unescape_formatter());
+		}
+
+		//  url_escape  ------------------------------------------------//
+
+		//! URL percent escape finder
+		/*!
+			Construct the finder of runs of characters, which are escaped
+			by the URL percent escape.
+
+			\return An instance of the \c escape_finder object
+		*/
+		inline detail::escape_finderF url_escape_finder()
+		{
+			return detail::escape_finderF(detail::url_escape_table());
+		}
+
+		//! URL percent escape formatter
+		/*!
+			Construct the formatter, which writes the URL percent escape sequences
+			of the characters of a match.
+
+			\return An instance of the \c escape_formatter object
+		*/
+		inline detail::escape_formatF url_escape_formatter()
+		{
+			return detail::escape_formatF(detail::url_escape_table());
+		}
+
+		//! URL percent escape algorithm
+		/*!
+			All bytes except the unreserved characters of RFC 3986 (letters, digits
+			and -._~) are percent-encoded.
+			The result is a modified copy of the input. It is returned as a sequence
+			or copied to the output iterator.
+
+			\param Output An output iterator to which the result will be copied
+			\param Input An input string
+			\return An output iterator pointing just after the last inserted character or
+				a modified copy of the input
+		*/
+		template<typename OutputIteratorT, typename RangeT>
+		inline OutputIteratorT url_escape_copy(
+			OutputIteratorT Output,
+			const RangeT& Input)
+		{
+			return ::string_algo::algorithm::find_format_all_copy(
+				Output,
+				Input,
+				::string_algo::algorithm::url_escape_finder(),
+				::string_algo::algorithm::url_escape_formatter());
+		}
+
+		//! URL percent escape algorithm
+		/*!
+			\overload
+		*/
+		template<typename SequenceT>
+		inline SequenceT url_escape_copy(const SequenceT& Input)
+		{
+			return ::string_algo::algorithm::find_format_all_copy(
+				Input,
+				::string_algo::algorithm::url_escape_finder(),
+				::string_algo::algorithm::url_escape_formatter());
+		}
+
+		//! URL percent escape algorithm
+		/*!
+			All bytes except the unreserved characters of RFC 3986 (letters, digits
+			and -._~) are percent-encoded.
+			The input sequence is modified in-place.
+
+			\param Input An input string
+		*/
+		template<typename SequenceT>
+		inline void url_escape(SequenceT& Input)
+		{
+			::string_algo::algorithm::find_format_all(
+				Input,
+				::string_algo::algorithm::url_escape_finder(),
+				::string_algo::algorithm::url_escape_formatter());
+		}
+
+		//  url_unescape  ----------------------------------------------//
+
+		//! URL percent unescape finder
+		/*!
+			Construct the finder of well formed URL percent escape sequences.
+
+			\return An instance of the \c unescape_finder object
+		*/
+		inline detail::unescape_finderF<detail::url_decoder> url_unescape_finder()
+		{
+			return detail::unescape_finderF<detail::url_decoder>();
+		}
+
+		//! URL percent unescape formatter
+		/*!
+			Construct the formatter, which writes the decoded URL percent escape sequence.
+
+			\return An instance of the \c unescape_formatter object
+		*/
+		inline detail::unescape_formatF<detail::url_decoder> url_unescape_formatter()
+		{
+			return detail::unescape_formatF<detail::url_decoder>();
+		}
+
+		//! URL percent unescape algorithm
+		/*!
+			%XX sequences are decoded. Malformed sequences and '+' characters are kept
+			as they are.
+			The result is a modified copy of the input. It is returned as a sequence
+			or copied to the output iterator.
+
+			\param Output An output iterator to which the result will be copied
+			\param Input An input string
+			\return An output iterator pointing just after the last inserted character or
+				a modified copy of the input
+		*/
+		template<typename OutputIteratorT, typename RangeT>
+		inline OutputIteratorT url_unescape_copy(
+			OutputIteratorT Output,
+			const RangeT& Input)
+		{
+			return ::string_algo::algorithm::find_format_all_copy(
+				Output,
+				Input,
+				::string_algo::algorithm::url_unescape_finder(),
+				::string_algo::algorithm::url_unescape_formatter());
+		}
+
+		//! URL percent unescape algorithm
+		/*!
+			\overload
+		*/
+		template<typename SequenceT>
+		inline SequenceT url_unescape_copy(const SequenceT& Input)
+		{
+			return ::string_algo::algorithm::find_format_all_copy(
+				Input,
+				::string_algo::algorithm::url_unescape_finder(),
+				::string_algo::algorithm::url_unescape_formatter());
+		}
+
+		//! URL percent unescape algorithm
+		/*!
+			%XX sequences are decoded. Malformed sequences and '+' characters are kept
+			as they are.
+			The input sequence is modified in-place.
+
+			\param Input An input string
+		*/
+		template<typename SequenceT>
+		inline void url_unescape(SequenceT& Input)
+		{
+			::string_algo::algorithm::find_format_all(
+				Input,
+				::string_algo::algorithm::url_unescape_finder(),
+				::string_algo::algorithm::url_unescape_formatter());
+		}
+
+	} // namespace algorithm
+
+	// pull names to the boost namespace
+	using algorithm::json_escape_finder;
+	using algorithm::json_escape_formatter;
+	using algorithm::json_escape_copy;
+	using algorithm::json_escape;
+	using algorithm::json_unescape_finder;
+	using algorithm::json_unescape_formatter;
+	using algorithm::json_unescape_copy;
+	using algorithm::json_unescape;
+	using algorithm::html_escape_finder;
+	using algorithm::html_escape_formatter;
+	using algorithm::html_escape_copy;
+	using algorithm::html_escape;
+	using algorithm::html_unescape_finder;
+	using algorithm::html_unescape_formatter;
+	using algorithm::html_unescape_copy;
+	using algorithm::html_unescape;
+	using algorithm::url_escape_finder;
+	using algorithm::url_escape_formatter;
+	using algorithm::url_escape_copy;
+	using algorithm::url_escape;
+	using algorithm::url_unescape_finder;
+	using algorithm::url_unescape_formatter;
+	using algorithm::url_unescape_copy;
+	using algorithm::url_unescape;
+
+} // namespace string_algo
+
+
+#endif  // STRING_ESCAPE_HPP
@@ -14,6 +14,11 @@
     Defines generic replace algorithms. Each algorithm replaces
     part(s) of the input. The part to be replaced is looked up using a Finder object.
     Result of finding is then used by a Formatter object to generate the replacement.
+
+    The find_format_all algorithms also accept writer formatters. A writer formatter
+    is invoked as <tt>Formatter(Match, Output)</tt> with an output iterator, writes
+    the replacement itself and returns the advanced iterator. No temporary
+    replacement is created for a match.
 */
 
 namespace string_algo {
@@ -73,10 +78,12 @@ namespace string_algo {
             FormatterT Formatter )
         {
           
+            auto lit_input=::string_algo::as_literal(Input);
+
             return detail::find_format_copy_impl(
                 Input,
                 Formatter,
-                Finder(::std::begin(Input), ::std::end(Input)));
+                Finder( ::std::begin(lit_input), ::std::end(lit_input) ) );
         }
 
         //! Generic replace algorithm
@@ -99,10 +106,12 @@ namespace string_algo {
         {
          
 
+            auto lit_input=::string_algo::as_literal(Input);
+
             detail::find_format_impl(
                 Input,
                 Formatter,
-                Finder(::std::begin(Input), ::std::end(Input)));
+                Finder( ::std::begin(lit_input), ::std::end(lit_input) ) );
         }
 
 
@@ -123,7 +132,9 @@ namespace string_algo {
             \return An output iterator pointing just after the last inserted character or
                 a modified copy of the input
 
-             \note The second variant of this function provides the strong exception-safety guarantee
+             \note The second variant of this function provides the strong exception-safety guarantee.
+                It reserves space for the result up front, exactly for formatters with
+                a fixed result size.
         */
         template< 
             typename OutputIteratorT,
@@ -163,11 +174,13 @@ namespace string_algo {
         {
            
 
+            auto lit_input=::string_algo::as_literal(Input);
+
             return detail::find_format_all_copy_impl(
                 Input,
                 Finder,
                 Formatter,
-                Finder( ::std::begin(Input), ::std::end(Input) ) );
+                Finder( ::std::begin(lit_input), ::std::end(lit_input) ) );
         }
 
         //! Generic replace all algorithm
@@ -221,11 +221,11 @@ namespace string_algo {
 		/*!
 			\overload
 		*/
-		template< typename ForwardIteratorT >
-		inline detail::range_finderF<ForwardIteratorT>
-			range_finder(std::span<typename ForwardIteratorT::value_type> Range)
+		template< typename CharT >
+		inline detail::range_finderF<typename std::span<CharT>::iterator>
+			range_finder(std::span<CharT> Range)
 		{
-			return detail::range_finderF<ForwardIteratorT>(Range);
+			return detail::range_finderF<typename std::span<CharT>::iterator>(Range);
 		}
 
 	} // namespace algorithm
@@ -0,0 +1,120 @@
+
+#ifndef STRING_IHASH_HPP
+#define STRING_IHASH_HPP
+
+#include <cstddef>
+#include <locale>
+
+#include "as_literal.hpp"
+#include "detail/ihash.hpp"
+
+/*! \file
+	Defines case insensitive hash and equality functors for unordered containers.
+
+	Both functors are transparent, so a container keyed by \c std::string
+	can be searched with a \c std::string_view or a string literal without
+	building a key. Neither of them builds a lower-cased copy of its arguments.
+*/
+
+namespace string_algo {
+	namespace algorithm {
+
+		//  ihash  -----------------------------------------------//
+
+		//! Case insensitive hash
+		/*!
+			Hash of a string, which ignores case. Strings, which are equal by
+			\c iequal_to with the same locale, have the same hash.
+
+			Narrow characters are folded through the case tables of the locale,
+			in locales, which convert ASCII like the classic locale, 16 bytes at a time.
+			The folded characters are hashed as they are produced.
+		*/
+		struct ihash
+		{
+			//! Heterogeneous lookup support
+			typedef void is_transparent;
+
+			//! Constructor
+			/*!
+				\param Loc A locale used for case folding
+			*/
+			ihash(const std::locale& Loc = std::locale()) :
+				m_Table(detail::get_ctype_table(Loc)) {}
+
+			//! Function operator
+			/*!
+				\param Key A string, a string view or a null terminated string
+				\return The hash of the key
+			*/
+			template<typename RangeT>
+			std::size_t operator()(const RangeT& Key) const
+			{
+				auto lit_key = ::string_algo::as_literal(Key);
+
+				return static_cast<std::size_t>(
+					::string_algo::algorithm::detail::ihash_range(lit_key.data(), lit_key.size(), *m_Table));
+			}
+
+		private:
+			detail::ctype_table_ptr m_Table;
+		};
+
+		//  iequal_to  -----------------------------------------------//
+
+		//! Case insensitive string equality
+		/*!
+			Compare two strings ignoring case, like \c iequals. The strings are
+			folded and compared 16 bytes at a time, where the locale allows it.
+		*/
+		struct iequal_to
+		{
+			//! Heterogeneous lookup support
+			typedef void is_transparent;
+
+			//! Constructor
+			/*!
+				\param Loc A locale used for comparison
+			*/
+			iequal_to(const std::locale& Loc = std::locale()) :
+				m_Table(detail::get_ctype_table(Loc)) {}
+
+			//! Function operator
+			/*!
+				\return True, if the strings are equal ignoring case
+			*/
+			template<typename Range1T, typename Range2T>
+			bool operator()(const Range1T& Arg1, const Range2T& Arg2) const
+			{
+				auto lit_arg1 = ::string_algo::as_literal(Arg1);
+				auto lit_arg2 = ::string_algo::as_literal(Arg2);
+
+				if (lit_arg1.size() != lit_arg2.size()) return false;
+
+				if constexpr (detail::is_byte_char<typename decltype(lit_arg1)::element_type>::value &&
+					detail::is_byte_char<typename decltype(lit_arg2)::element_type>::value)
+				{
+					return ::string_algo::algorithm::detail::iequal_bytes(
+						lit_arg1.data(), lit_arg2.data(), lit_arg1.size(), *m_Table);
+				}
+				else
+				{
+					return ::string_algo::algorithm::detail::imismatch(
+						lit_arg1.data(), lit_arg2.data(), lit_arg1.size(), *m_Table) == lit_arg1.size();
+				}
+			}
+
+		private:
+			detail::ctype_table_ptr m_Table;
+		};
+
+	} // namespace algorithm
+
+	// pull names to the boost namespace
+	using algorithm::ihash;
+	using algorithm::iequal_to;
+
+} // namespace string_algo
+
+
+#endif  // STRING_IHASH_HPP
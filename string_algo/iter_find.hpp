@@ -13,6 +13,8 @@
 #include "concept.hpp"
 #include "find_iterator.hpp"
 #include "detail/util.hpp"
+#include "detail/split.hpp"
+#include "token_columns.hpp"
 
 /*! \file
     Defines generic split algorithms. Split algorithms can be 
@@ -100,6 +102,50 @@ namespace string_algo {
             return Result;
         }
 
+        //! Iter find algorithm
+        /*!
+            \overload
+
+            Matches are stored directly into the offset and length columns
+            of the result. No copy of the matches is created.
+        */
+        template< 
+            typename CharT,
+            typename OffsetT,
+            typename RangeT,
+            typename FinderT >
+        inline token_columns<CharT, OffsetT>&
+        iter_find(
+            token_columns<CharT, OffsetT>& Result,
+            RangeT&& Input,
+            FinderT Finder )
+        {
+            auto lit_input=::string_algo::as_literal(Input);
+
+            typedef typename decltype(lit_input)::iterator input_iterator_type;
+
+            Result.assign_input( lit_input.data(), lit_input.size() );
+
+            input_iterator_type InputBegin=::std::begin(lit_input);
+            input_iterator_type InputEnd=::std::end(lit_input);
+
+            std::size_t Next=0;
+            for(;;)
+            {
+                auto M=Finder( InputBegin+Next, InputEnd );
+                if( M.empty() )
+                {
+                    break;
+                }
+
+                std::size_t Offset=static_cast<std::size_t>(M.data()-lit_input.data());
+                Result.push_back( Offset, M.size() );
+                Next=Offset+M.size();
+            }
+
+            return Result;
+        }
+
 //  iterate split ---------------------------------------------------//
 
         //! Split find algorithm
@@ -171,6 +217,38 @@ namespace string_algo {
             return Result;
         }
 
+        //! Split find algorithm
+        /*!
+            \overload
+
+            Segments are stored directly into the offset and length columns
+            of the result. No copy of the segments is created.
+        */
+        template< 
+            typename CharT,
+            typename OffsetT,
+            typename RangeT,
+            typename FinderT >
+        inline token_columns<CharT, OffsetT>&
+        iter_split(
+            token_columns<CharT, OffsetT>& Result,
+            RangeT&& Input,
+            FinderT Finder )
+        {
+            auto lit_input=::string_algo::as_literal(Input);
+
+            Result.assign_input( lit_input.data(), lit_input.size() );
+
+            ::string_algo::algorithm::detail::split_chunk(
+                lit_input, 0, lit_input.size(), Finder, false,
+                [&Result]( std::size_t Offset, std::size_t Length )
+                {
+                    Result.push_back( Offset, Length );
+                } );
+
+            return Result;
+        }
+
     } // namespace algorithm
 
     // pull names to the boost namespace
@@ -4,7 +4,19 @@
 #define STRING_JOIN_HPP
 
 
-#include "detail/sequence.hpp"
+#include <cstddef>
+#include <span>
+#include <string>
+#include <vector>
+
+#if defined(__has_include)
+#if __has_include(<sys/uio.h>)
+#include <sys/uio.h>
+#define STRING_ALGO_HAS_IOVEC
+#endif
+#endif
+
+#include "detail/join.hpp"
 #include "as_literal.hpp"
 
 /*! \file
@@ -14,6 +26,13 @@
     It joins strings from a 'list' by adding user defined separator.
     Additionally there is a version that allows simple filtering
     by providing a predicate.
+
+    Besides returning a new string, the result can be appended to an existing
+    sequence (join_to) or written to an output iterator or a buffer (join_copy).
+    join_iov describes the result as a scatter-gather list without building it.
+
+    The result is built in two passes. The first one computes its exact
+    size, the second one allocates it once and copies the segments.
 */
 
 namespace string_algo {
@@ -38,33 +57,12 @@ namespace string_algo {
             const SequenceSequenceT& Input,
             const Range1T& Separator)
         {
-            // Define working types
             typedef typename SequenceSequenceT::value_type ResultT;
-            typedef typename SequenceSequenceT::const_iterator InputIteratorT;
-
-            // Parse input
-            InputIteratorT itBegin=::std::begin(Input);
-            InputIteratorT itEnd=::std::end(Input);
-
-            // Construct container to hold the result
-            ResultT Result;
-            
-            // Append first element
-            if(itBegin!=itEnd)
-            {
-                detail::insert(Result, ::std::end(Result), *itBegin);
-                ++itBegin;
-            }
-
-            for(;itBegin!=itEnd; ++itBegin)
-            {
-                // Add separator
-                detail::insert(Result, ::std::end(Result), ::string_algo::as_literal(Separator));
-                // Add element
-                detail::insert(Result, ::std::end(Result), *itBegin);
-            }
 
-            return Result;
+            return ::string_algo::algorithm::detail::join_impl<ResultT>(
+                Input,
+                ::string_algo::as_literal(Separator),
+                ::string_algo::algorithm::detail::join_allF());
         }
 
 // join_if ----------------------------------------------------------//
@@ -77,7 +75,7 @@ namespace string_algo {
 
             \param Input A container that holds the input strings. It must be a container-of-containers.
             \param Separator A string that will separate the joined segments.
-            \param Pred A segment selection predicate
+            \param Pred A segment selection predicate. It is invoked once for every segment.
             \return Concatenated string.
 
             \note This function provides the strong exception-safety guarantee
@@ -89,45 +87,230 @@ namespace string_algo {
             const Range1T& Separator,
             PredicateT Pred)
         {
-            // Define working types
             typedef typename SequenceSequenceT::value_type ResultT;
-            typedef typename SequenceSequenceT::const_iterator InputIteratorT;
 
-            // Parse input
-            InputIteratorT itBegin=::std::begin(Input);
-            InputIteratorT itEnd=::std::end(Input);
+            return ::string_algo::algorithm::detail::join_impl<ResultT>(
+                Input,
+                ::string_algo::as_literal(Separator),
+                Pred);
+        }
+
+// parallel_join ----------------------------------------------------//
+
+        //! Parallel join algorithm
+        /*!
+            This algorithm joins all strings in a 'list' into one long string,
+            with the same result as \c join. The work is divided between several
+            threads. Segment sizes are summed per chunk of segments, an exclusive
+            prefix sum of the chunk sizes gives the position of every chunk in
+            the result. The result is allocated once, then every thread copies
+            its segments to their final positions.
+
+            \param Input A random access container that holds the input strings.
+                It must be a container-of-containers with a contiguous value type.
+            \param Separator A string that will separate the joined segments.
+            \param Concurrency Maximal number of threads to use. Zero selects
+                \c std::thread::hardware_concurrency(). Short lists are always
+                processed by the calling thread only.
+            \return Concatenated string.
+        */
+        template< typename SequenceSequenceT, typename Range1T>
+        inline typename SequenceSequenceT::value_type
+        parallel_join(
+            const SequenceSequenceT& Input,
+            const Range1T& Separator,
+            unsigned int Concurrency=0)
+        {
+            typedef typename SequenceSequenceT::value_type ResultT;
+
+            return ::string_algo::algorithm::detail::parallel_join_impl<ResultT>(
+                Input,
+                ::string_algo::as_literal(Separator),
+                Concurrency);
+        }
+
+// join_to ----------------------------------------------------------//
+
+        //! Join algorithm, append variant
+        /*!
+            This algorithm joins all strings in a 'list' and appends the result
+            to the output sequence. Spare capacity of the output is reused,
+            it is grown at most once.
+
+            \param Output A sequence to append the result to
+            \param Input A container that holds the input strings. It must be a container-of-containers.
+            \param Separator A string that will separate the joined segments.
+        */
+        template< typename SequenceT, typename SequenceSequenceT, typename Range1T>
+        inline void join_to(
+            SequenceT& Output,
+            const SequenceSequenceT& Input,
+            const Range1T& Separator)
+        {
+            auto lit_separator=::string_algo::as_literal(Separator);
+            ::string_algo::algorithm::detail::join_allF Pred;
+
+            std::size_t Count=0;
+            const typename SequenceSequenceT::value_type* Single=nullptr;
+            std::size_t Size=::string_algo::algorithm::detail::join_size(
+                Input, lit_separator, Pred, Count, Single);
+
+            ::string_algo::algorithm::detail::join_append(
+                Output, Size, Input, lit_separator, Pred);
+        }
+
+// join_copy --------------------------------------------------------//
+
+        //! Join algorithm, output iterator variant
+        /*!
+            This algorithm joins all strings in a 'list' and writes the result
+            to the output iterator.
+
+            \param Output An output iterator to which the result will be copied
+            \param Input A container that holds the input strings. It must be a container-of-containers.
+            \param Separator A string that will separate the joined segments.
+            \return An output iterator pointing just after the last inserted character
+        */
+        template< typename OutputIteratorT, typename SequenceSequenceT, typename Range1T>
+        inline OutputIteratorT join_copy(
+            OutputIteratorT Output,
+            const SequenceSequenceT& Input,
+            const Range1T& Separator)
+        {
+            ::string_algo::algorithm::detail::join_allF Pred;
 
-            // Construct container to hold the result
-            ResultT Result;
+            return ::string_algo::algorithm::detail::join_write(
+                Output, Input, ::string_algo::as_literal(Separator), Pred);
+        }
+
+        //! Join algorithm, buffer variant
+        /*!
+            This algorithm joins all strings in a 'list' into a caller supplied buffer.
+            The result is written only if it fits into the buffer, otherwise the buffer
+            is left untouched.
 
-            // Roll to the first element that will be added
-            while(itBegin!=itEnd && !Pred(*itBegin)) ++itBegin;
-            // Add this element
-            if(itBegin!=itEnd)
+            \param Output A buffer to which the result will be copied
+            \param Input A container that holds the input strings. It must be a container-of-containers.
+            \param Separator A string that will separate the joined segments.
+            \return The size of the result. If it is larger than the size of
+                the buffer, nothing has been written.
+        */
+        template< typename CharT, typename SequenceSequenceT, typename Range1T>
+        inline std::size_t join_copy(
+            std::span<CharT> Output,
+            const SequenceSequenceT& Input,
+            const Range1T& Separator)
+        {
+            auto lit_separator=::string_algo::as_literal(Separator);
+            ::string_algo::algorithm::detail::join_allF Pred;
+
+            std::size_t Count=0;
+            const typename SequenceSequenceT::value_type* Single=nullptr;
+            std::size_t Size=::string_algo::algorithm::detail::join_size(
+                Input, lit_separator, Pred, Count, Single);
+
+            if(Size<=Output.size())
             {
-                detail::insert(Result, ::std::end(Result), *itBegin);
-                ++itBegin;
+                ::string_algo::algorithm::detail::join_write(
+                    Output.data(), Input, lit_separator, Pred);
             }
 
-            for(;itBegin!=itEnd; ++itBegin)
+            return Size;
+        }
+
+// join_iov ---------------------------------------------------------//
+
+        //! Scatter-gather entry
+        /*!
+            \c ::iovec where \c <sys/uio.h> is available, so that the result of
+            \c join_iov can be passed to \c writev or \c sendmsg directly.
+            Elsewhere a structure with the same members.
+        */
+#if defined(STRING_ALGO_HAS_IOVEC)
+        typedef ::iovec join_iovec;
+#else
+        struct join_iovec
+        {
+            void* iov_base;
+            std::size_t iov_len;
+        };
+#endif
+
+        //! Scatter-gather join algorithm
+        /*!
+            This algorithm describes the join of all strings in a 'list' as a list
+            of <tt>(pointer, length)</tt> entries, alternating segments and separators.
+            No joined string is built. Writing the entries in order produces the same
+            bytes as \c join. Empty pieces are omitted.
+
+            Entries refer to the input segments, all separator entries refer
+            to the storage of the separator itself. Both must outlive the result.
+            Lengths are in bytes.
+
+            \param Input A container that holds the input strings. It must be a container-of-containers
+                with a contiguous value type.
+            \param Separator A string that will separate the joined segments.
+            \return A list of scatter-gather entries
+
+            \note \c writev accepts at most \c IOV_MAX entries per call.
+        */
+        template< typename SequenceSequenceT, typename Range1T>
+        inline std::vector<join_iovec> join_iov(
+            const SequenceSequenceT& Input,
+            const Range1T& Separator)
+        {
+            auto lit_separator=::string_algo::as_literal(Separator);
+
+            auto Entry=[](const auto& Piece)
+            {
+                join_iovec Result;
+                Result.iov_base=const_cast<void*>(static_cast<const void*>(std::ranges::data(Piece)));
+                Result.iov_len=std::ranges::size(Piece)*sizeof(*std::ranges::data(Piece));
+                return Result;
+            };
+
+            std::vector<join_iovec> Result;
+            std::size_t Segments=static_cast<std::size_t>(std::ranges::size(Input));
+            Result.reserve(Segments==0 ? 0 : Segments*2-1);
+
+            bool bFirst=true;
+            for(const auto& Segment : Input)
             {
-                if(Pred(*itBegin))
+                if(!bFirst && !lit_separator.empty())
+                {
+                    Result.push_back(Entry(lit_separator));
+                }
+                if(!std::ranges::empty(Segment))
                 {
-                    // Add separator
-                    detail::insert(Result, ::std::end(Result), ::boost::as_literal(Separator));
-                    // Add element
-                    detail::insert(Result, ::std::end(Result), *itBegin);
+                    Result.push_back(Entry(Segment));
                 }
+                bFirst=false;
             }
 
             return Result;
         }
 
+        //! Scatter-gather join algorithm
+        /*!
+            \overload
+
+            Entries referring to a temporary separator would dangle.
+        */
+        template< typename SequenceSequenceT, typename CharT, typename TraitsT, typename AllocatorT>
+        void join_iov(
+            const SequenceSequenceT& Input,
+            std::basic_string<CharT, TraitsT, AllocatorT>&& Separator) = delete;
+
     } // namespace algorithm
 
     // pull names to the boost namespace
     using algorithm::join;
     using algorithm::join_if;
+    using algorithm::parallel_join;
+    using algorithm::join_to;
+    using algorithm::join_copy;
+    using algorithm::join_iovec;
+    using algorithm::join_iov;
 
 } // namespace string_algo
 
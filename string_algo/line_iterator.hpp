@@ -0,0 +1,286 @@
+
+#ifndef STRING_LINE_ITERATOR_HPP
+#define STRING_LINE_ITERATOR_HPP
+
+#include <cstddef>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include "as_literal.hpp"
+#include "constants.hpp"
+#include "detail/simd.hpp"
+
+/*! \file
+	Defines line iteration facilities. Lines are delimited by a line feed,
+	which is searched for by a vectorized scan. A carriage return preceding
+	the line feed can be stripped, so both LF and CR/LF terminated inputs
+	are handled. Lines are yielded as views of the input.
+
+	Empty lines are preserved. A line feed at the very end of the input
+	does not start an additional empty line.
+*/
+
+namespace string_algo {
+	namespace algorithm {
+
+		//  line_iterator  -----------------------------------------------//
+
+		//! line_iterator
+		/*!
+			Line iterator yields the lines of an input as views.
+
+			Line iterator is a readable forward traversal iterator.
+			A default constructed iterator is the end iterator.
+		*/
+		template<typename CharT>
+		class line_iterator
+		{
+		public:
+			// typedefs
+			typedef std::forward_iterator_tag iterator_category;
+			typedef std::basic_string_view<CharT> value_type;
+			typedef std::ptrdiff_t difference_type;
+			typedef const value_type* pointer;
+			typedef const value_type& reference;
+
+		public:
+			//! Default constructor
+			/*!
+				Construct null iterator. All null iterators are equal.
+
+				\post eof()==true
+			*/
+			line_iterator() :
+				m_Next(nullptr), m_End(nullptr), m_eCrMode(line_strip_cr), m_bEof(true) {}
+
+			//! Constructor
+			/*!
+				Construct new line_iterator for a given range.
+			*/
+			line_iterator(
+				const CharT* Begin,
+				const CharT* End,
+				line_cr_mode_type eCrMode = line_strip_cr) :
+				m_Next(Begin), m_End(End), m_eCrMode(eCrMode), m_bEof(false)
+			{
+				increment();
+			}
+
+		public:
+			// iterator operations
+
+			// dereference
+			const value_type& dereference() const
+			{
+				return m_Line;
+			}
+
+			// increment
+			void increment()
+			{
+				if (m_Next == m_End)
+				{
+					m_bEof = true;
+					m_Line = value_type();
+					return;
+				}
+
+				const CharT* LineEnd = ::string_algo::algorithm::detail::find_char(m_Next, m_End, CharT('\n'));
+
+				m_Line = value_type(m_Next, static_cast<std::size_t>(LineEnd - m_Next));
+				m_Next = (LineEnd == m_End) ? m_End : LineEnd + 1;
+
+				if (m_eCrMode == line_strip_cr && !m_Line.empty() && m_Line.back() == CharT('\r'))
+				{
+					m_Line.remove_suffix(1);
+				}
+			}
+
+			//! Eof check
+			/*!
+				Check the eof condition. Eof condition means that
+				there are no more lines in the input.
+			*/
+			bool eof() const
+			{
+				return m_bEof;
+			}
+
+			// standard iterator interface
+			const value_type& operator*() const { return m_Line; }
+			const value_type* operator->() const { return &m_Line; }
+			line_iterator& operator++() { increment(); return *this; }
+			line_iterator operator++(int) { line_iterator Tmp(*this); increment(); return Tmp; }
+
+			friend bool operator==(const line_iterator& Lhs, const line_iterator& Rhs)
+			{
+				return Lhs.m_bEof || Rhs.m_bEof ?
+					Lhs.m_bEof == Rhs.m_bEof :
+					Lhs.m_Line.data() == Rhs.m_Line.data() && Lhs.m_End == Rhs.m_End;
+			}
+
+		private:
+			// Attributes
+			value_type m_Line;
+			const CharT* m_Next;
+			const CharT* m_End;
+			line_cr_mode_type m_eCrMode;
+			bool m_bEof;
+		};
+
+		//! Range of lines
+		/*!
+			A pair of line iterators, usable in a range based for loop.
+		*/
+		template<typename CharT>
+		class line_range
+		{
+		public:
+			typedef line_iterator<CharT> iterator;
+			typedef line_iterator<CharT> const_iterator;
+
+			line_range(const CharT* Begin, const CharT* End, line_cr_mode_type eCrMode) :
+				m_Begin(Begin, End, eCrMode) {}
+
+			iterator begin() const { return m_Begin; }
+			iterator end() const { return iterator(); }
+
+		private:
+			iterator m_Begin;
+		};
+
+		//! Lines of an input
+		/*!
+			Construct a range of the lines of the input.
+
+			\param Input An input sequence. The lines refer to it.
+			\param eCrMode Handling of a carriage return at the end of a line
+			\return A range of line views
+		*/
+		template<typename RangeT>
+		inline auto lines(
+			const RangeT& Input,
+			line_cr_mode_type eCrMode = line_strip_cr)
+		{
+			auto lit_input = ::string_algo::as_literal(Input);
+
+			typedef std::remove_const_t<typename decltype(lit_input)::element_type> char_type;
+
+			return line_range<char_type>(lit_input.data(), lit_input.data() + lit_input.size(), eCrMode);
+		}
+
+		//! Lines of an input
+		/*!
+			\overload
+
+			Lines of a temporary string would refer to a destroyed object.
+		*/
+		template<typename CharT, typename TraitsT, typename AllocatorT>
+		void lines(
+			std::basic_string<CharT, TraitsT, AllocatorT>&& Input,
+			line_cr_mode_type eCrMode = line_strip_cr) = delete;
+
+		//  line_splitter  -----------------------------------------------//
+
+		//! Streaming line splitter
+		/*!
+			Splits a chunked input into lines. Chunks are fed one by one, complete
+			lines are passed to a callback as views. Lines contained in a single chunk
+			refer directly to the chunk; only a line crossing a chunk boundary is
+			assembled in an internal buffer.
+
+			Views passed to the callback are valid only during the call.
+		*/
+		template<typename CharT>
+		class line_splitter
+		{
+		public:
+			typedef std::basic_string_view<CharT> value_type;
+
+			//! Constructor
+			/*!
+				\param eCrMode Handling of a carriage return at the end of a line
+			*/
+			explicit line_splitter(line_cr_mode_type eCrMode = line_strip_cr) :
+				m_eCrMode(eCrMode) {}
+
+			//! Feed a chunk
+			/*!
+				Invoke Line(view) for every line completed by the chunk.
+				An incomplete last line is kept until the next chunk or finish().
+			*/
+			template<typename FunctionT>
+			void feed(value_type Chunk, FunctionT Line)
+			{
+				const CharT* Next = Chunk.data();
+				const CharT* End = Next + Chunk.size();
+
+				while (Next != End)
+				{
+					const CharT* LineEnd = ::string_algo::algorithm::detail::find_char(Next, End, CharT('\n'));
+					if (LineEnd == End)
+					{
+						// Incomplete line, keep it for the next chunk
+						m_Pending.append(Next, End);
+						return;
+					}
+
+					if (m_Pending.empty())
+					{
+						Line(strip(value_type(Next, static_cast<std::size_t>(LineEnd - Next))));
+					}
+					else
+					{
+						m_Pending.append(Next, LineEnd);
+						Line(strip(value_type(m_Pending)));
+						m_Pending.clear();
+					}
+
+					Next = LineEnd + 1;
+				}
+			}
+
+			//! Finish the input
+			/*!
+				Invoke Line(view) for the last line, if it was not terminated
+				by a line feed. The splitter is ready for a new input afterwards.
+			*/
+			template<typename FunctionT>
+			void finish(FunctionT Line)
+			{
+				if (!m_Pending.empty())
+				{
+					Line(strip(value_type(m_Pending)));
+					m_Pending.clear();
+				}
+			}
+
+		private:
+			value_type strip(value_type Line) const
+			{
+				if (m_eCrMode == line_strip_cr && !Line.empty() && Line.back() == CharT('\r'))
+				{
+					Line.remove_suffix(1);
+				}
+				return Line;
+			}
+
+		private:
+			std::basic_string<CharT> m_Pending;
+			line_cr_mode_type m_eCrMode;
+		};
+
+	} // namespace algorithm
+
+	// pull names to the boost namespace
+	using algorithm::line_iterator;
+	using algorithm::line_range;
+	using algorithm::lines;
+	using algorithm::line_splitter;
+
+} // namespace string_algo
+
+
+#endif  // STRING_LINE_ITERATOR_HPP
@@ -0,0 +1,276 @@
+
+#ifndef STRING_MULTI_REPLACE_HPP
+#define STRING_MULTI_REPLACE_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "as_literal.hpp"
+#include "constants.hpp"
+#include "detail/aho_corasick.hpp"
+#include "detail/sequence.hpp"
+
+/*! \file
+	Defines multi-pattern replace algorithms. A set of search strings, each with
+	its own substitute, is replaced in a single pass over the input. The search
+	strings are compiled into one Aho-Corasick automaton.
+
+	Matches are selected leftmost first, and they do not overlap. A substitute
+	is never searched again, so the result does not depend on the order
+	of the pairs, unlike a chain of replace_all calls.
+*/
+
+namespace string_algo {
+	namespace algorithm {
+
+		//  multi_replacer  ----------------------------------------------//
+
+		//! Multi-pattern replacer
+		/*!
+			Compiled set of (search, substitute) pairs. The replacer owns copies
+			of all strings, so it can be constructed once and reused.
+
+			If several search strings match at the leftmost position, the match
+			is selected according to the selection mode: the longest one, or
+			the one given first. Empty search strings are ignored.
+		*/
+		template<typename CharT>
+		class multi_replacer
+		{
+		public:
+			// typedefs
+			typedef CharT char_type;
+			typedef std::basic_string_view<CharT> view_type;
+			typedef std::pair<view_type, view_type> pair_type;
+
+		public:
+			//! Constructor
+			/*!
+				\param Map (search, substitute) pairs
+				\param eMode Selection of a match among the ones starting at the same position
+			*/
+			multi_replacer(
+				std::initializer_list<pair_type> Map,
+				match_select_mode_type eMode = match_leftmost_longest)
+			{
+				assign(Map.begin(), Map.end(), eMode);
+			}
+
+			//! Constructor
+			/*!
+				\param Begin The beginning of a sequence of (search, substitute) pairs
+				\param End The end of the sequence
+				\param eMode Selection of a match among the ones starting at the same position
+			*/
+			template<typename IteratorT>
+			multi_replacer(
+				IteratorT Begin,
+				IteratorT End,
+				match_select_mode_type eMode = match_leftmost_longest)
+			{
+				assign(Begin, End, eMode);
+			}
+
+			//! Replace all matches, copy variant
+			/*!
+				\param Output An output iterator to which the result will be copied
+				\param Input An input sequence
+				\return An output iterator pointing just after the last inserted character
+			*/
+			template<typename OutputIteratorT>
+			OutputIteratorT replace_all_copy(OutputIteratorT Output, view_type Input) const
+			{
+				std::size_t Next = 0;
+				for (detail::multi_match Match = m_Automaton.find(Input, 0);
+					Match.pattern != npos;
+					Match = m_Automaton.find(Input, Next))
+				{
+					Output = std::copy(Input.data() + Next, Input.data() + Match.begin, Output);
+					view_type Format = format(Match.pattern);
+					Output = std::copy(Format.begin(), Format.end(), Output);
+					Next = Match.end;
+				}
+
+				return std::copy(Input.data() + Next, Input.data() + Input.size(), Output);
+			}
+
+			//! Replace all matches, append variant
+			/*!
+				The result is appended to the output sequence. Space for
+				at least the size of the input is reserved up front.
+
+				\param Output A sequence to append the result to
+				\param Input An input sequence
+			*/
+			template<typename SequenceT>
+			void replace_all_append(SequenceT& Output, view_type Input) const
+			{
+				::string_algo::algorithm::detail::reserve(Output, Output.size() + Input.size());
+
+				std::size_t Next = 0;
+				for (detail::multi_match Match = m_Automaton.find(Input, 0);
+					Match.pattern != npos;
+					Match = m_Automaton.find(Input, Next))
+				{
+					Output.insert(Output.end(), Input.data() + Next, Input.data() + Match.begin);
+					view_type Format = format(Match.pattern);
+					Output.insert(Output.end(), Format.begin(), Format.end());
+					Next = Match.end;
+				}
+
+				Output.insert(Output.end(), Input.data() + Next, Input.data() + Input.size());
+			}
+
+			//! Replace all matches in-place
+			/*!
+				The result is built in a single sweep into a new sequence, which
+				then replaces the input. The input is not modified if nothing matches.
+
+				\param Input An input sequence
+			*/
+			template<typename SequenceT>
+			void replace_all(SequenceT& Input) const
+			{
+				view_type lit_input(std::ranges::data(Input), std::ranges::size(Input));
+
+				if (m_Automaton.find(lit_input, 0).pattern == npos)
+				{
+					return;
+				}
+
+				SequenceT Output;
+				replace_all_append(Output, lit_input);
+				Input = std::move(Output);
+			}
+
+		private:
+			static constexpr std::size_t npos = detail::aho_corasick<CharT>::npos;
+
+			template<typename IteratorT>
+			void assign(IteratorT Begin, IteratorT End, match_select_mode_type eMode)
+			{
+				for (; Begin != End; ++Begin)
+				{
+					view_type Search(Begin->first);
+					view_type Format(Begin->second);
+
+					m_Automaton.insert(Search);
+					m_Formats.emplace_back(m_Storage.size(), Format.size());
+					m_Storage.append(Format.data(), Format.size());
+				}
+
+				m_Automaton.compile(eMode);
+			}
+
+			view_type format(std::size_t Pattern) const
+			{
+				return view_type(m_Storage.data() + m_Formats[Pattern].first, m_Formats[Pattern].second);
+			}
+
+		private:
+			detail::aho_corasick<CharT> m_Automaton;
+			std::basic_string<CharT> m_Storage;
+			std::vector< std::pair<std::size_t, std::size_t> > m_Formats;
+		};
+
+		namespace detail {
+
+			// Character type of a range
+			template<typename RangeT>
+			using range_char_t = std::remove_const_t<
+				typename decltype(::string_algo::as_literal(std::declval<const RangeT&>()))::element_type>;
+
+			// Multi-pattern replace map of a range
+			template<typename RangeT>
+			using replace_map_t = std::initializer_list<
+				std::pair<std::basic_string_view<range_char_t<RangeT>>, std::basic_string_view<range_char_t<RangeT>>>>;
+
+		} // namespace detail
+
+		//  replace_all ( multi-pattern )  -------------------------------//
+
+		//! Multi-pattern replace all algorithm
+		/*!
+			Replace all occurrences of the search strings in the input
+			with their substitutes, in a single pass.
+			The result is a modified copy of the input. It is returned as a sequence
+			or copied to the output iterator.
+
+			\param Output An output iterator to which the result will be copied
+			\param Input An input string
+			\param Map (search, substitute) pairs, e.g. <tt>{{"&","&amp;"},{"<","&lt;"}}</tt>
+			\param eMode Selection of a match among the ones starting at the same position
+			\return An output iterator pointing just after the last inserted character or
+				a modified copy of the input
+		*/
+		template<typename OutputIteratorT, typename RangeT>
+		inline OutputIteratorT replace_all_copy(
+			OutputIteratorT Output,
+			const RangeT& Input,
+			detail::replace_map_t<RangeT> Map,
+			match_select_mode_type eMode = match_leftmost_longest)
+		{
+			auto lit_input = ::string_algo::as_literal(Input);
+
+			return multi_replacer<detail::range_char_t<RangeT>>(Map, eMode).replace_all_copy(
+				Output,
+				std::basic_string_view<detail::range_char_t<RangeT>>(lit_input.data(), lit_input.size()));
+		}
+
+		//! Multi-pattern replace all algorithm
+		/*!
+			\overload
+		*/
+		template<typename SequenceT>
+		inline SequenceT replace_all_copy(
+			const SequenceT& Input,
+			detail::replace_map_t<SequenceT> Map,
+			match_select_mode_type eMode = match_leftmost_longest)
+		{
+			auto lit_input = ::string_algo::as_literal(Input);
+
+			SequenceT Output;
+			multi_replacer<detail::range_char_t<SequenceT>>(Map, eMode).replace_all_append(
+				Output,
+				std::basic_string_view<detail::range_char_t<SequenceT>>(lit_input.data(), lit_input.size()));
+			return Output;
+		}
+
+		//! Multi-pattern replace all algorithm
+		/*!
+			Replace all occurrences of the search strings in the input
+			with their substitutes, in a single pass.
+			The input sequence is modified in-place.
+
+			\param Input An input string
+			\param Map (search, substitute) pairs, e.g. <tt>{{"&","&amp;"},{"<","&lt;"}}</tt>
+			\param eMode Selection of a match among the ones starting at the same position
+		*/
+		template<typename SequenceT>
+		inline void replace_all(
+			SequenceT& Input,
+			detail::replace_map_t<SequenceT> Map,
+			match_select_mode_type eMode = match_leftmost_longest)
+		{
+			multi_replacer<detail::range_char_t<SequenceT>>(Map, eMode).replace_all(Input);
+		}
+
+	} // namespace algorithm
+
+	// pull names to the boost namespace
+	using algorithm::multi_replacer;
+	using algorithm::replace_all;
+	using algorithm::replace_all_copy;
+
+} // namespace string_algo
+
+
+#endif  // STRING_MULTI_REPLACE_HPP
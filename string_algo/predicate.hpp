@@ -8,6 +8,7 @@
 #include "compare.hpp"
 #include "find.hpp"
 #include "detail/predicate.hpp"
+#include "detail/ihash.hpp"
 
 /*! \file boost/algorithm/string/predicate.hpp
 	Defines string-related predicates.
@@ -400,6 +401,78 @@ namespace string_algo {
 			return ::string_algo::algorithm::lexicographical_compare(Arg1, Arg2, is_iless(Loc));
 		}
 
+		//! Three-way lexicographical compare (case-insensitive)
+		/*!
+			Compare two strings ignoring case. The strings are ordered like
+			by \c ilexicographical_compare, but the result is three-way.
+
+			The first mismatch is found by folding and comparing 16 bytes at
+			a time, where the locale allows it. Only that position is ordered.
+
+			 \param Arg1 First argument
+			 \param Arg2 Second argument
+			 \param Loc A locale used for case insensitive comparison
+			 \return A negative value, if Arg1 is less than Arg2, zero, if they are
+				equal ignoring case, and a positive value otherwise
+
+			 \note This function provides the strong exception-safety guarantee
+		 */
+		template<typename Range1T, typename Range2T>
+		inline int ilexicographical_compare3(
+			const Range1T& Arg1,
+			const Range2T& Arg2,
+			const std::locale& Loc = std::locale())
+		{
+			auto lit_arg1(::string_algo::as_literal(Arg1));
+			auto lit_arg2(::string_algo::as_literal(Arg2));
+
+			return ::string_algo::algorithm::detail::icompare3(
+				lit_arg1.data(), lit_arg1.size(),
+				lit_arg2.data(), lit_arg2.size(),
+				*detail::get_ctype_table(Loc));
+		}
+
+		//  iless  -----------------------------------------------//
+
+		//! Case insensitive string ordering
+		/*!
+			A transparent comparator for ordered containers, which orders strings
+			like \c ilexicographical_compare. A container keyed by \c std::string
+			can be searched with a \c std::string_view or a string literal without
+			building a key.
+		 */
+		struct iless
+		{
+			//! Heterogeneous lookup support
+			typedef void is_transparent;
+
+			//! Constructor
+			/*!
+				\param Loc A locale used for comparison
+			*/
+			iless(const std::locale& Loc = std::locale()) :
+				m_Table(detail::get_ctype_table(Loc)) {}
+
+			//! Function operator
+			/*!
+				\return True, if Arg1 is less than Arg2 ignoring case
+			*/
+			template<typename Range1T, typename Range2T>
+			bool operator()(const Range1T& Arg1, const Range2T& Arg2) const
+			{
+				auto lit_arg1(::string_algo::as_literal(Arg1));
+				auto lit_arg2(::string_algo::as_literal(Arg2));
+
+				return ::string_algo::algorithm::detail::icompare3(
+					lit_arg1.data(), lit_arg1.size(),
+					lit_arg2.data(), lit_arg2.size(),
+					*m_Table) < 0;
+			}
+
+		private:
+			detail::ctype_table_ptr m_Table;
+		};
+
 
 		//  all predicate  -----------------------------------------------//
 
@@ -448,6 +521,8 @@ namespace string_algo {
 	using algorithm::all;
 	using algorithm::lexicographical_compare;
 	using algorithm::ilexicographical_compare;
+	using algorithm::ilexicographical_compare3;
+	using algorithm::iless;
 
 } // namespace string_algo 
 
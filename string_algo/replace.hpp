@@ -9,6 +9,7 @@
 #include "finder.hpp"
 #include "formatter.hpp"
 #include "compare.hpp"
+#include "multi_replace.hpp"
 
 /*! \file
     Defines various replace algorithms. Each algorithm replaces
@@ -50,7 +51,7 @@ namespace string_algo {
                 Output,
                 Input,
                 ::string_algo::algorithm::range_finder(SearchRange),
-                ::string_algo::algorithm::const_formatter(Format));
+                ::string_algo::algorithm::const_formatter(::string_algo::as_literal(Format)));
         }
 
         //! Replace range algorithm
@@ -67,7 +68,7 @@ namespace string_algo {
             return ::string_algo::algorithm::find_format_copy(
                 Input,
                 ::string_algo::algorithm::range_finder(SearchRange),
-                ::string_algo::algorithm::const_formatter(Format));
+                ::string_algo::algorithm::const_formatter(::string_algo::as_literal(Format)));
         }
 
         //! Replace range algorithm
@@ -89,7 +90,7 @@ namespace string_algo {
             ::string_algo::algorithm::find_format(
                 Input,
                 ::string_algo::algorithm::range_finder(SearchRange),
-                ::string_algo::algorithm::const_formatter(Format));
+                ::string_algo::algorithm::const_formatter(::string_algo::as_literal(Format)));
         }
 
 //  replace_first --------------------------------------------------------------------//
@@ -124,8 +125,8 @@ namespace string_algo {
             return ::string_algo::algorithm::find_format_copy(
                 Output,
                 Input,
-                ::string_algo::algorithm::first_finder(Search),
-                ::string_algo::algorithm::const_formatter(Format) );
+                ::string_algo::algorithm::first_finder(::string_algo::as_literal(Search)),
+                ::string_algo::algorithm::const_formatter(::string_algo::as_literal(Format)) );
         }
 
         //! Replace first algorithm
@@ -140,8 +141,8 @@ namespace string_algo {
         {
             return ::string_algo::algorithm::find_format_copy( 
                 Input,
-                ::string_algo::algorithm::first_finder(Search),
-                ::string_algo::algorithm::const_formatter(Format) );
+                ::string_algo::algorithm::first_finder(::string_algo::as_literal(Search)),
+                ::string_algo::algorithm::const_formatter(::string_algo::as_literal(Format)) );
         }
 
         //! Replace first algorithm
@@ -161,8 +162,8 @@ namespace string_algo {
         {
             ::string_algo::algorithm::find_format( 
                 Input, 
-                ::string_algo::algorithm::first_finder(Search),
-                ::string_algo::algorithm::const_formatter(Format) );
+                ::string_algo::algorithm::first_finder(::string_algo::as_literal(Search)),
+                ::string_algo::algorithm::const_formatter(::string_algo::as_literal(Format)) );
         }
 
 //  replace_first ( case insensitive ) ---------------------------------------------//
@@ -200,8 +201,8 @@ namespace string_algo {
             return ::string_algo::algorithm::find_format_copy(
                 Output,
                 Input,
-                ::string_algo::algorithm::first_finder(Search, is_iequal(Loc)),
-                ::string_algo::algorithm::const_formatter(Format) );
+                ::string_algo::algorithm::first_finder(::string_algo::as_literal(Search), is_iequal(Loc)),
+                ::string_algo::algorithm::const_formatter(::string_algo::as_literal(Format)) );
         }
 
         //! Replace first algorithm ( case insensitive )
@@ -217,8 +218,8 @@ namespace string_algo {
         {
             return ::string_algo::algorithm::find_format_copy( 
                 Input,
-                ::string_algo::algorithm::first_finder(Search, is_iequal(Loc)),
-                ::string_algo::algorithm::const_formatter(Format) );
+                ::string_algo::algorithm::first_finder(::string_algo::as_literal(Search), is_iequal(Loc)),
+                ::string_algo::algorithm::const_formatter(::string_algo::as_literal(Format)) );
         }
 
         //! Replace first algorithm ( case insensitive )
@@ -241,8 +242,8 @@ namespace string_algo {
         {
             ::string_algo::algorithm::find_format( 
                 Input, 
-                ::string_algo::algorithm::first_finder(Search, is_iequal(Loc)),
-                ::string_algo::algorithm::const_formatter(Format) );
+                ::string_algo::algorithm::first_finder(::string_algo::as_literal(Search), is_iequal(Loc)),
+                ::string_algo::algorithm::const_formatter(::string_algo::as_literal(Format)) );
         }
 
 //  replace_last --------------------------------------------------------------------//
@@ -277,8 +278,8 @@ namespace string_algo {
             return ::string_algo::algorithm::find_format_copy(
                 Output,
                 Input,
-                ::string_algo::algorithm::last_finder(Search),
-                ::string_algo::algorithm::const_formatter(Format) );
+                ::string_algo::algorithm::last_finder(::string_algo::as_literal(Search)),
+                ::string_algo::algorithm::const_formatter(::string_algo::as_literal(Format)) );
         }
 
         //! Replace last algorithm
@@ -293,8 +294,8 @@ namespace string_algo {
         {
             return ::string_algo::algorithm::find_format_copy( 
                 Input,
-                ::string_algo::algorithm::last_finder(Search),
-                ::string_algo::algorithm::const_formatter(Format) );
+                ::string_algo::algorithm::last_finder(::string_algo::as_literal(Search)),
+                ::string_algo::algorithm::const_formatter(::string_algo::as_literal(Format)) );
         }
 
         //! Replace last algorithm
@@ -314,8 +315,8 @@ namespace string_algo {
         {
             ::string_algo::algorithm::find_format( 
                 Input, 
-                ::string_algo::algorithm::last_finder(Search),
-                ::string_algo::algorithm::const_formatter(Format) );
+                ::string_algo::algorithm::last_finder(::string_algo::as_literal(Search)),
+                ::string_algo::algorithm::const_formatter(::string_algo::as_literal(Format)) );
         }
 
 //  replace_last ( case insensitive ) -----------------------------------------------//
@@ -353,8 +354,8 @@ namespace string_algo {
             return ::string_algo::algorithm::find_format_copy(
                 Output,
                 Input,
-                ::string_algo::algorithm::last_finder(Search, is_iequal(Loc)),
-                ::string_algo::algorithm::const_formatter(Format) );
+                ::string_algo::algorithm::last_finder(::string_algo::as_literal(Search), is_iequal(Loc)),
+                ::string_algo::algorithm::const_formatter(::string_algo::as_literal(Format)) );
         }
 
         //! Replace last algorithm ( case insensitive )
@@ -370,8 +371,8 @@ namespace string_algo {
         {
             return ::string_algo::algorithm::find_format_copy( 
                 Input,
-                ::string_algo::algorithm::last_finder(Search, is_iequal(Loc)),
-                ::string_algo::algorithm::const_formatter(Format) );
+                ::string_algo::algorithm::last_finder(::string_algo::as_literal(Search), is_iequal(Loc)),
+                ::string_algo::algorithm::const_formatter(::string_algo::as_literal(Format)) );
         }
 
         //! Replace last algorithm ( case insensitive )
@@ -394,8 +395,8 @@ namespace string_algo {
         {
             ::string_algo::algorithm::find_format( 
                 Input, 
-                ::string_algo::algorithm::last_finder(Search, is_iequal(Loc)),
-                ::string_algo::algorithm::const_formatter(Format) );
+                ::string_algo::algorithm::last_finder(::string_algo::as_literal(Search), is_iequal(Loc)),
+                ::string_algo::algorithm::const_formatter(::string_algo::as_literal(Format)) );
         }
 
 //  replace_nth --------------------------------------------------------------------//
@@ -433,8 +434,8 @@ namespace string_algo {
             return ::string_algo::algorithm::find_format_copy(
                 Output,
                 Input,
-                ::string_algo::algorithm::nth_finder(Search, Nth),
-                ::string_algo::algorithm::const_formatter(Format) );
+                ::string_algo::algorithm::nth_finder(::string_algo::as_literal(Search), Nth),
+                ::string_algo::algorithm::const_formatter(::string_algo::as_literal(Format)) );
         }
 
         //! Replace nth algorithm
@@ -450,8 +451,8 @@ namespace string_algo {
         {
             return ::string_algo::algorithm::find_format_copy( 
                 Input,
-                ::string_algo::algorithm::nth_finder(Search, Nth),
-                ::string_algo::algorithm::const_formatter(Format) );
+                ::string_algo::algorithm::nth_finder(::string_algo::as_literal(Search), Nth),
+                ::string_algo::algorithm::const_formatter(::string_algo::as_literal(Format)) );
         }
 
         //! Replace nth algorithm
@@ -474,8 +475,8 @@ namespace string_algo {
         {
             ::string_algo::algorithm::find_format( 
                 Input, 
-                ::string_algo::algorithm::nth_finder(Search, Nth),
-                ::string_algo::algorithm::const_formatter(Format) );
+                ::string_algo::algorithm::nth_finder(::string_algo::as_literal(Search), Nth),
+                ::string_algo::algorithm::const_formatter(::string_algo::as_literal(Format)) );
         }
 
 //  replace_nth ( case insensitive ) -----------------------------------------------//
@@ -516,8 +517,8 @@ namespace string_algo {
             return ::string_algo::algorithm::find_format_copy(
                 Output,
                 Input,
-                ::string_algo::algorithm::nth_finder(Search, Nth, is_iequal(Loc) ),
-                ::string_algo::algorithm::const_formatter(Format) );
+                ::string_algo::algorithm::nth_finder(::string_algo::as_literal(Search), Nth, is_iequal(Loc) ),
+                ::string_algo::algorithm::const_formatter(::string_algo::as_literal(Format)) );
         }
 
         //! Replace nth algorithm ( case insensitive )
@@ -534,8 +535,8 @@ namespace string_algo {
         {
             return ::string_algo::algorithm::find_format_copy(
                 Input,
-                ::string_algo::algorithm::nth_finder(Search, Nth, is_iequal(Loc)),
-                ::string_algo::algorithm::const_formatter(Format) );
+                ::string_algo::algorithm::nth_finder(::string_algo::as_literal(Search), Nth, is_iequal(Loc)),
+                ::string_algo::algorithm::const_formatter(::string_algo::as_literal(Format)) );
         }
 
         //! Replace nth algorithm ( case insensitive )
@@ -561,8 +562,8 @@ namespace string_algo {
         {
             ::string_algo::algorithm::find_format(
                 Input, 
-                ::string_algo::algorithm::nth_finder(Search, Nth, is_iequal(Loc)),
-                ::string_algo::algorithm::const_formatter(Format) );
+                ::string_algo::algorithm::nth_finder(::string_algo::as_literal(Search), Nth, is_iequal(Loc)),
+                ::string_algo::algorithm::const_formatter(::string_algo::as_literal(Format)) );
         }
 
 //  replace_all --------------------------------------------------------------------//
@@ -588,6 +589,7 @@ namespace string_algo {
             typename Range1T, 
             typename Range2T,
             typename Range3T>
+            requires (!detail::is_contiguous_sequence<OutputIteratorT>::value)
         inline OutputIteratorT replace_all_copy(
             OutputIteratorT Output,
             const Range1T& Input,
@@ -597,8 +599,8 @@ namespace string_algo {
             return ::string_algo::algorithm::find_format_all_copy(
                 Output,
                 Input,
-                ::string_algo::algorithm::first_finder(Search),
-                ::string_algo::algorithm::const_formatter(Format) );
+                ::string_algo::algorithm::first_finder(::string_algo::as_literal(Search)),
+                ::string_algo::algorithm::const_formatter(::string_algo::as_literal(Format)) );
         }
 
         //! Replace all algorithm
@@ -613,8 +615,46 @@ namespace string_algo {
         {
             return ::string_algo::algorithm::find_format_all_copy(
                 Input,
-                ::string_algo::algorithm::first_finder(Search),
-                ::string_algo::algorithm::const_formatter(Format) );
+                ::string_algo::algorithm::first_finder(::string_algo::as_literal(Search)),
+                ::string_algo::algorithm::const_formatter(::string_algo::as_literal(Format)) );
+        }
+
+        //! Replace all algorithm
+        /*!
+            \overload
+
+            The result is stored to a caller supplied sequence. Its previous
+            content is discarded, but its capacity is reused; space for the
+            result is reserved exactly before copying.
+            The output must not overlap the input.
+
+            \param Output A sequence to store the result to
+            \return A reference to the output
+        */
+        template<
+            typename SequenceT,
+            typename Range1T,
+            typename Range2T,
+            typename Range3T>
+            requires detail::is_contiguous_sequence<SequenceT>::value
+        inline SequenceT& replace_all_copy(
+            SequenceT& Output,
+            const Range1T& Input,
+            const Range2T& Search,
+            const Range3T& Format )
+        {
+            auto lit_input=::string_algo::as_literal(Input);
+            auto Finder=::string_algo::algorithm::first_finder(::string_algo::as_literal(Search));
+
+            Output.clear();
+            ::string_algo::algorithm::detail::find_format_all_copy_to(
+                Output,
+                lit_input,
+                Finder,
+                ::string_algo::algorithm::const_formatter(::string_algo::as_literal(Format)),
+                Finder( ::std::begin(lit_input), ::std::end(lit_input) ) );
+
+            return Output;
         }
 
         //! Replace all algorithm
@@ -673,8 +713,8 @@ namespace string_algo {
             return ::string_algo::algorithm::find_format_all_copy(
                 Output,
                 Input,
-                ::string_algo::algorithm::first_finder(Search, is_iequal(Loc)),
-                ::string_algo::algorithm::const_formatter(Format) );
+                ::string_algo::algorithm::first_finder(::string_algo::as_literal(Search), is_iequal(Loc)),
+                ::string_algo::algorithm::const_formatter(::string_algo::as_literal(Format)) );
         }
 
         //! Replace all algorithm ( case insensitive )
@@ -690,8 +730,8 @@ namespace string_algo {
         {
             return ::string_algo::algorithm::find_format_all_copy(
                 Input,
-                ::string_algo::algorithm::first_finder(Search, is_iequal(Loc)),
-                ::string_algo::algorithm::const_formatter(Format) );
+                ::string_algo::algorithm::first_finder(::string_algo::as_literal(Search), is_iequal(Loc)),
+                ::string_algo::algorithm::const_formatter(::string_algo::as_literal(Format)) );
         }
 
         //! Replace all algorithm ( case insensitive )
@@ -714,8 +754,8 @@ namespace string_algo {
         {
             ::string_algo::algorithm::find_format_all(
                 Input, 
-                ::string_algo::algorithm::first_finder(Search, is_iequal(Loc)),
-                ::string_algo::algorithm::const_formatter(Format) );
+                ::string_algo::algorithm::first_finder(::string_algo::as_literal(Search), is_iequal(Loc)),
+                ::string_algo::algorithm::const_formatter(::string_algo::as_literal(Format)) );
         }
         
 //  replace_head --------------------------------------------------------------------//
@@ -754,7 +794,7 @@ namespace string_algo {
                 Output,
                 Input,
                 ::string_algo::algorithm::head_finder(N),
-                ::string_algo::algorithm::const_formatter(Format) );
+                ::string_algo::algorithm::const_formatter(::string_algo::as_literal(Format)) );
         }
 
         //! Replace head algorithm
@@ -770,7 +810,7 @@ namespace string_algo {
             return ::string_algo::algorithm::find_format_copy(
                 Input,
                 ::string_algo::algorithm::head_finder(N),
-                ::string_algo::algorithm::const_formatter(Format) );
+                ::string_algo::algorithm::const_formatter(::string_algo::as_literal(Format)) );
         }
 
         //! Replace head algorithm
@@ -795,7 +835,7 @@ namespace string_algo {
             ::string_algo::algorithm::find_format(
                 Input, 
                 ::string_algo::algorithm::head_finder(N),
-                ::string_algo::algorithm::const_formatter(Format) );
+                ::string_algo::algorithm::const_formatter(::string_algo::as_literal(Format)) );
         }
 
 //  replace_tail --------------------------------------------------------------------//
@@ -834,7 +874,7 @@ namespace string_algo {
                 Output,
                 Input,
                 ::string_algo::algorithm::tail_finder(N),
-                ::string_algo::algorithm::const_formatter(Format) );
+                ::string_algo::algorithm::const_formatter(::string_algo::as_literal(Format)) );
         }
 
         //! Replace tail algorithm
@@ -850,7 +890,7 @@ namespace string_algo {
             return ::string_algo::algorithm::find_format_copy(
                 Input,
                 ::string_algo::algorithm::tail_finder(N),
-                ::string_algo::algorithm::const_formatter(Format) );
+                ::string_algo::algorithm::const_formatter(::string_algo::as_literal(Format)) );
         }
 
         //! Replace tail algorithm
@@ -875,7 +915,7 @@ namespace string_algo {
             ::string_algo::algorithm::find_format( 
                 Input, 
                 ::string_algo::algorithm::tail_finder(N),
-                ::string_algo::algorithm::const_formatter(Format) );
+                ::string_algo::algorithm::const_formatter(::string_algo::as_literal(Format)) );
         }
 
     } // namespace algorithm
@@ -0,0 +1,143 @@
+
+#ifndef STRING_REPLACE_BATCH_HPP
+#define STRING_REPLACE_BATCH_HPP
+
+#include <cstddef>
+#include <ranges>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "as_literal.hpp"
+#include "detail/replace_batch.hpp"
+
+/*! \file
+	Defines batched replace algorithms. The same replacement is applied to every
+	sequence of a collection. The search string is preprocessed once and shared,
+	the sequences are processed by several threads.
+*/
+
+namespace string_algo {
+	namespace algorithm {
+
+		//  replace_all_batch  -------------------------------------------//
+
+		//! Batched replace all algorithm
+		/*!
+			Replace all occurrences of the search string with the format string in every
+			sequence of the collection. The sequences are modified in-place.
+
+			The search string is compiled once for the whole batch. Records are
+			distributed between the threads dynamically, in small blocks claimed from
+			a shared counter. Every thread builds the results in its own scratch buffer,
+			which is swapped with the modified record, so buffers are recycled instead
+			of allocated per record. Records without a match are not touched.
+
+			\param Inputs A random access collection of strings, e.g. \c std::vector<std::string>
+				or \c std::span<std::string>
+			\param Search A substring to be searched for
+			\param Format A substitute string
+			\param Concurrency Maximal number of threads to use. Zero selects
+				\c std::thread::hardware_concurrency(). Small batches are always
+				processed by the calling thread only.
+		*/
+		template<typename SequenceSequenceT, typename Range1T, typename Range2T>
+		inline void replace_all_batch(
+			SequenceSequenceT&& Inputs,
+			const Range1T& Search,
+			const Range2T& Format,
+			unsigned int Concurrency = 0)
+		{
+			typedef std::remove_cvref_t<std::ranges::range_reference_t<SequenceSequenceT>> sequence_type;
+			typedef typename sequence_type::value_type char_type;
+			typedef std::basic_string_view<char_type> view_type;
+
+			auto lit_search = ::string_algo::as_literal(Search);
+			auto lit_format = ::string_algo::as_literal(Format);
+
+			detail::batch_searcher<char_type> Searcher(view_type(lit_search.data(), lit_search.size()));
+			view_type FormatView(lit_format.data(), lit_format.size());
+
+			auto First = std::ranges::begin(Inputs);
+			std::size_t Count = static_cast<std::size_t>(std::ranges::size(Inputs));
+
+			unsigned int Workers = detail::resolve_concurrency(
+				Concurrency, Count, detail::replace_batch_min_records);
+			std::vector< detail::batch_scratch<sequence_type> > Scratch(Workers);
+
+			detail::run_batch(Count, Workers,
+				[&](unsigned int Worker, std::size_t Record)
+				{
+					sequence_type& Input = First[Record];
+					sequence_type& Buffer = Scratch[Worker].Buffer;
+
+					if (detail::replace_all_searcher(Buffer, view_type(Input.data(), Input.size()), Searcher, FormatView))
+					{
+						using std::swap;
+						swap(Input, Buffer);
+					}
+				});
+		}
+
+		//! Batched replace all algorithm
+		/*!
+			Replace all occurrences of the search string with the format string in every
+			sequence of the collection. The results are returned as a new collection,
+			in the order of the inputs.
+
+			\param Inputs A random access collection of strings
+			\param Search A substring to be searched for
+			\param Format A substitute string
+			\param Concurrency Maximal number of threads to use. Zero selects
+				\c std::thread::hardware_concurrency().
+			\return A vector of the modified copies of the inputs
+		*/
+		template<typename SequenceSequenceT, typename Range1T, typename Range2T>
+		inline std::vector< std::remove_cvref_t<std::ranges::range_reference_t<const SequenceSequenceT&>> >
+		replace_all_batch_copy(
+			const SequenceSequenceT& Inputs,
+			const Range1T& Search,
+			const Range2T& Format,
+			unsigned int Concurrency = 0)
+		{
+			typedef std::remove_cvref_t<std::ranges::range_reference_t<const SequenceSequenceT&>> sequence_type;
+			typedef typename sequence_type::value_type char_type;
+			typedef std::basic_string_view<char_type> view_type;
+
+			auto lit_search = ::string_algo::as_literal(Search);
+			auto lit_format = ::string_algo::as_literal(Format);
+
+			detail::batch_searcher<char_type> Searcher(view_type(lit_search.data(), lit_search.size()));
+			view_type FormatView(lit_format.data(), lit_format.size());
+
+			auto First = std::ranges::begin(Inputs);
+			std::size_t Count = static_cast<std::size_t>(std::ranges::size(Inputs));
+
+			std::vector<sequence_type> Result(Count);
+
+			detail::run_batch(Count,
+				detail::resolve_concurrency(Concurrency, Count, detail::replace_batch_min_records),
+				[&](unsigned int, std::size_t Record)
+				{
+					const sequence_type& Input = First[Record];
+
+					if (!detail::replace_all_searcher(Result[Record], view_type(Input.data(), Input.size()), Searcher, FormatView))
+					{
+						Result[Record] = Input;
+					}
+				});
+
+			return Result;
+		}
+
+	} // namespace algorithm
+
+	// pull names to the boost namespace
+	using algorithm::replace_all_batch;
+	using algorithm::replace_all_batch_copy;
+
+} // namespace string_algo
+
+
+#endif  // STRING_REPLACE_BATCH_HPP
@@ -2,10 +2,15 @@
 #ifndef STRING_SPLIT_HPP
 #define STRING_SPLIT_HPP
 
+#include <array>
+#include <cstddef>
+#include <string_view>
+#include <type_traits>
 
 #include "iter_find.hpp"
 #include "finder.hpp"
 #include "compare.hpp"
+#include "detail/split.hpp"
 
 /*! \file
     Defines basic split algorithms. 
@@ -19,6 +24,9 @@
     a reference to it (e.g. using the iterator range class).
     Examples of such a container are \c std::vector<std::string>
     or \c std::list<boost::iterator_range<std::string::iterator>>
+
+    Alternatively the result can be a \c token_columns container, which
+    stores only offsets and lengths of the parts.
 */
 
 namespace string_algo {
@@ -139,12 +147,253 @@ namespace string_algo {
                 ::string_algo::algorithm::token_finder( Pred, eCompress ) );         
         }
 
+//  fixed capacity tokenize  ----------------------------------------------//
+
+        //! Fixed capacity token container
+        /*!
+            Result of \c split_fixed. Holds up to N views of the input inline,
+            without any dynamic allocation. If the input contains more tokens,
+            the container is marked as overflowed and the remaining, not tokenized,
+            part of the input is available through \c remainder().
+        */
+        template< typename CharT, std::size_t N >
+        class fixed_tokens
+        {
+        public:
+            // typedefs
+            typedef std::basic_string_view<CharT> value_type;
+            typedef std::size_t size_type;
+            typedef const value_type* const_iterator;
+            typedef const_iterator iterator;
+
+        public:
+            //! Default constructor
+            /*!
+                Construct an empty container
+            */
+            fixed_tokens() noexcept : m_Size(0), m_bOverflow(false) {}
+
+            // Size
+            size_type size() const noexcept { return m_Size; }
+            bool empty() const noexcept { return m_Size==0; }
+            static constexpr size_type capacity() noexcept { return N; }
+
+            // Access
+            const value_type& operator[]( size_type Index ) const noexcept { return m_Tokens[Index]; }
+            const_iterator begin() const noexcept { return m_Tokens.data(); }
+            const_iterator end() const noexcept { return m_Tokens.data()+m_Size; }
+
+            //! Overflow check
+            /*!
+                \return true if the input contains more than N tokens
+            */
+            bool overflow() const noexcept { return m_bOverflow; }
+
+            //! Not tokenized part of the input
+            /*!
+                \return The part of the input following the separator
+                    after the last stored token. Empty if there was no overflow.
+            */
+            const value_type& remainder() const noexcept { return m_Remainder; }
+
+            // Construction interface used by split_fixed
+            void push_back( value_type Token ) noexcept { m_Tokens[m_Size++]=Token; }
+            void set_remainder( value_type Remainder ) noexcept
+            {
+                m_Remainder=Remainder;
+                m_bOverflow=true;
+            }
+
+        private:
+            std::array<value_type, N> m_Tokens;
+            size_type m_Size;
+            value_type m_Remainder;
+            bool m_bOverflow;
+        };
+
+        //! Fixed capacity split algorithm
+        /*!
+            Tokenize expression with the same semantics as \c split, storing at most
+            N tokens in an inline container of views. The algorithm does not allocate
+            any memory. If the input holds more than N tokens, the result is marked
+            as overflowed and the rest of the input is available as its remainder.
+
+            \param Input A container which will be searched. The result refers to it.
+            \param Pred A predicate to identify separators. This predicate is 
+                supposed to return true if a given element is a separator.
+                It is used by reference and must not throw.
+            \param eCompress If eCompress argument is set to token_compress_on, adjacent 
+                separators are merged together. Otherwise, every two separators
+                delimit a token.
+            \return A \c fixed_tokens container with views of the tokens
+        */
+        template< std::size_t N, typename RangeT, typename PredicateT >
+        inline fixed_tokens<
+            std::remove_const_t<typename decltype(::string_algo::as_literal(std::declval<const RangeT&>()))::element_type>, N>
+        split_fixed(
+            const RangeT& Input,
+            const PredicateT& Pred,
+            token_compress_mode_type eCompress=token_compress_off ) noexcept
+        {
+            auto lit_input=::string_algo::as_literal(Input);
+
+            typedef std::remove_const_t<typename decltype(lit_input)::element_type> char_type;
+            typedef fixed_tokens<char_type, N> result_type;
+            typedef typename result_type::value_type view_type;
+
+            result_type Result;
+
+            std::size_t Rest=::string_algo::algorithm::detail::split_bounded(
+                lit_input,
+                N,
+                Pred,
+                eCompress,
+                [&Result, &lit_input]( std::size_t Offset, std::size_t Length ) noexcept
+                {
+                    Result.push_back( view_type( lit_input.data()+Offset, Length ) );
+                } );
+
+            if( Rest<=lit_input.size() )
+            {
+                Result.set_remainder( view_type( lit_input.data()+Rest, lit_input.size()-Rest ) );
+            }
+
+            return Result;
+        }
+
+//  key/value split  ------------------------------------------------------//
+
+        //! Key/value split algorithm
+        /*!
+            Split the input into key/value pairs in a single pass. This is suitable
+            for logfmt records, query strings, cookie headers and similar formats.
+
+            Pairs are delimited by any of the pair delimiters, a key is separated
+            from its value by the first key/value delimiter in the pair. A pair without
+            the key/value delimiter yields an empty value. Empty pairs are skipped.
+            Keys and values are trimmed in the same pass.
+
+            Each pair is emitted as two views of the input, \c (key, value).
+            If Output is callable with two views, it is invoked for every pair.
+            Otherwise it is a container and a new element constructed from the
+            two views is added at its end, e.g. 
+                \c std::vector<std::pair<std::string_view,std::string_view>>
+
+            \param Output A callback or a container receiving the pairs
+            \param Input A container which will be searched.
+            \param PairDelims A set of characters delimiting pairs
+            \param KvDelim A character separating a key from its value
+            \param IsSpace A unary predicate identifying characters to be trimmed
+        */
+        template< typename OutputT, typename RangeT, typename DelimRangeT, typename CharT, typename PredicateT >
+        inline void split_kv(
+            OutputT&& Output,
+            const RangeT& Input,
+            const DelimRangeT& PairDelims,
+            CharT KvDelim,
+            PredicateT IsSpace )
+        {
+            auto lit_input=::string_algo::as_literal(Input);
+
+            typedef std::basic_string_view<
+                std::remove_const_t<typename decltype(lit_input)::element_type> > view_type;
+
+            ::string_algo::algorithm::detail::split_kv_impl(
+                lit_input,
+                ::string_algo::as_literal(PairDelims),
+                KvDelim,
+                IsSpace,
+                [&Output]( view_type Key, view_type Value )
+                {
+                    if constexpr( std::is_invocable_v<OutputT&, view_type, view_type> )
+                    {
+                        Output( Key, Value );
+                    }
+                    else
+                    {
+                        Output.emplace( Output.end(), Key, Value );
+                    }
+                } );
+        }
+
+        //! Key/value split algorithm
+        /*!
+            \overload
+
+            Keys and values are not trimmed.
+        */
+        template< typename OutputT, typename RangeT, typename DelimRangeT, typename CharT >
+        inline void split_kv(
+            OutputT&& Output,
+            const RangeT& Input,
+            const DelimRangeT& PairDelims,
+            CharT KvDelim )
+        {
+            ::string_algo::algorithm::split_kv(
+                Output, Input, PairDelims, KvDelim,
+                ::string_algo::algorithm::detail::kv_no_trimF() );
+        }
+
+//  parallel tokenize  ----------------------------------------------------//
+
+        //! Parallel split algorithm
+        /*!
+            Tokenize expression with the same semantics as \c split, performed
+            by several threads. The input is divided into chunks, each chunk
+            is tokenized independently. Chunk starts are moved to the first
+            separator following the nominal chunk start, so that no token
+            is torn between two chunks. Per-chunk results are combined
+            by an exclusive prefix sum of the token counts.
+
+            Tokens are stored as offsets into the input rather than copies.
+            Each element of the result is constructed from a pair
+            <tt>(offset, length)</tt>.
+            Typical type of the result is 
+                \c std::vector<std::pair<std::size_t,std::size_t>>
+
+            \param Result A random access container that can hold token offsets
+            \param Input A container which will be searched.
+            \param Pred A predicate to identify separators. This predicate is 
+                supposed to return true if a given element is a separator.
+                It is invoked concurrently and must be safe to do so.
+            \param eCompress If eCompress argument is set to token_compress_on, adjacent 
+                separators are merged together. Otherwise, every two separators
+                delimit a token.
+            \param Concurrency Maximal number of threads to use. Zero selects
+                \c std::thread::hardware_concurrency(). Small inputs are always
+                processed by the calling thread only.
+            \return A reference the result
+
+            \note Prior content of the result will be overwritten.
+        */
+        template< typename OffsetSequenceT, typename RangeT, typename PredicateT >
+        inline OffsetSequenceT& parallel_split(
+            OffsetSequenceT& Result,
+            const RangeT& Input,
+            PredicateT Pred,
+            token_compress_mode_type eCompress=token_compress_off,
+            unsigned int Concurrency=0 )
+        {
+            ::string_algo::algorithm::detail::parallel_split_impl(
+                Result,
+                ::string_algo::as_literal(Input),
+                Pred,
+                eCompress,
+                Concurrency );
+
+            return Result;
+        }
+
     } // namespace algorithm
 
     // pull names to the boost namespace
     using algorithm::find_all;
     using algorithm::ifind_all;
     using algorithm::split;    
+    using algorithm::parallel_split;
+    using algorithm::fixed_tokens;
+    using algorithm::split_fixed;
+    using algorithm::split_kv;
 
 } // namespace string_algo
 
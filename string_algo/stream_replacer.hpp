@@ -0,0 +1,237 @@
+
+#ifndef STRING_STREAM_REPLACER_HPP
+#define STRING_STREAM_REPLACER_HPP
+
+#include <concepts>
+#include <cstddef>
+#include <ranges>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+/*! \file
+	Defines the \c stream_replacer. It performs a replace all operation
+	on an input, which is delivered in chunks, and passes the result to
+	a sink in chunks as well. Only a bounded tail of the input, which may
+	be the beginning of a match, is kept between the chunks.
+*/
+
+namespace string_algo {
+	namespace algorithm {
+
+		namespace detail {
+
+			// Check if a finder knows the length of its matches
+			template<typename FinderT>
+			concept bounded_match_finder = requires(const FinderT& Finder)
+			{
+				{ Finder.match_size() } -> std::convertible_to<std::size_t>;
+			};
+
+		} // namespace detail
+
+		//  stream_replacer  ---------------------------------------------//
+
+		//! Streaming replace all
+		/*!
+			Replaces all matches of a finder in a chunked input. Chunks are fed one
+			by one, the result is passed to a sink callback as a sequence of views.
+			Views passed to the sink are valid only during the call.
+
+			The finder must not match more than \c MaxMatch characters. A match is
+			accepted once the input contains \c MaxMatch characters from its beginning,
+			so the finder has seen everything it could match. At most \c MaxMatch-1
+			characters are kept between the chunks, memory use does not depend on
+			the size of the input.
+
+			Most of a chunk is searched in place. Only a match crossing the chunk
+			boundary is searched in a small buffer joining the kept tail
+			and the beginning of the chunk.
+		*/
+		template<typename CharT, typename FinderT, typename FormatterT>
+		class stream_replacer
+		{
+		public:
+			// typedefs
+			typedef std::basic_string_view<CharT> value_type;
+
+		public:
+			//! Constructor
+			/*!
+				\param Finder A Finder object used to search for a match to be replaced
+				\param Formatter A Formatter object used to format a match
+				\param MaxMatch The maximal length of a match
+			*/
+			stream_replacer(FinderT Finder, FormatterT Formatter, std::size_t MaxMatch) :
+				m_Finder(Finder), m_Formatter(Formatter), m_MaxMatch(MaxMatch == 0 ? 1 : MaxMatch) {}
+
+			//! Constructor
+			/*!
+				The maximal length of a match is taken from the finder,
+				e.g. the length of the search string of a \c first_finder.
+			*/
+			stream_replacer(FinderT Finder, FormatterT Formatter)
+				requires detail::bounded_match_finder<FinderT> :
+				stream_replacer(Finder, Formatter, Finder.match_size()) {}
+
+			//! Feed a chunk
+			/*!
+				Invoke Sink(view) for the parts of the result, which are not affected
+				by the following chunks.
+			*/
+			template<typename SinkT>
+			void feed(value_type Chunk, SinkT Sink)
+			{
+				std::size_t Keep = m_MaxMatch - 1;
+
+				if (!m_Tail.empty())
+				{
+					if (Chunk.size() < Keep)
+					{
+						// Short chunk, search the joined buffer
+						m_Tail.append(Chunk.data(), Chunk.size());
+						std::size_t Next = process(value_type(m_Tail), Sink, false);
+						m_Tail.erase(0, Next);
+						return;
+					}
+
+					// Matches starting in the tail end within the first Keep characters of the chunk
+					std::size_t TailSize = m_Tail.size();
+					m_Tail.append(Chunk.data(), Keep);
+					std::size_t Next = process(value_type(m_Tail), Sink, false, TailSize);
+					m_Tail.clear();
+
+					Chunk.remove_prefix(Next - TailSize);
+				}
+
+				std::size_t Next = process(Chunk, Sink, false);
+				m_Tail.assign(Chunk.data() + Next, Chunk.size() - Next);
+			}
+
+			//! Finish the input
+			/*!
+				Invoke Sink(view) for the rest of the result.
+				The replacer is ready for a new input afterwards.
+			*/
+			template<typename SinkT>
+			void finish(SinkT Sink)
+			{
+				process(value_type(m_Tail), Sink, true);
+				m_Tail.clear();
+			}
+
+		private:
+			// Replace matches in Input starting before Limit
+			/*
+				If bLast is not set, only matches fully covered by MaxMatch characters
+				are accepted and Limit is also capped accordingly. The text preceding
+				Limit is emitted. Returns the offset of the first character,
+				which was not emitted (at least Limit).
+			*/
+			template<typename SinkT>
+			std::size_t process(value_type Input, SinkT& Sink, bool bLast, std::size_t Limit = static_cast<std::size_t>(-1))
+			{
+				typedef std::span<const CharT> range_type;
+
+				std::size_t Size = Input.size();
+				if (!bLast)
+				{
+					std::size_t Safe = Size >= m_MaxMatch - 1 ? Size - (m_MaxMatch - 1) : 0;
+					if (Safe < Limit) Limit = Safe;
+				}
+				if (Limit > Size) Limit = Size;
+
+				range_type lit_input(Input.data(), Size);
+
+				std::size_t Next = 0;
+				while (Next < Limit)
+				{
+					range_type M = m_Finder(lit_input.begin() + Next, lit_input.end());
+					std::size_t MatchBegin = static_cast<std::size_t>(M.data() - lit_input.data());
+					if (M.empty() || MatchBegin >= Limit)
+					{
+						break;
+					}
+
+					if (MatchBegin != Next)
+					{
+						Sink(Input.substr(Next, MatchBegin - Next));
+					}
+					emit(m_Formatter(M), Sink);
+
+					Next = MatchBegin + M.size();
+				}
+
+				if (Next < Limit)
+				{
+					Sink(Input.substr(Next, Limit - Next));
+					Next = Limit;
+				}
+
+				return Next;
+			}
+
+			// Pass a format result to the sink
+			template<typename FormatResultT, typename SinkT>
+			void emit(const FormatResultT& FormatResult, SinkT& Sink)
+			{
+				if constexpr (std::ranges::contiguous_range<const FormatResultT>)
+				{
+					value_type Format(std::ranges::data(FormatResult), std::ranges::size(FormatResult));
+					if (!Format.empty()) Sink(Format);
+				}
+				else
+				{
+					std::basic_string<CharT> Format(::std::begin(FormatResult), ::std::end(FormatResult));
+					if (!Format.empty()) Sink(value_type(Format));
+				}
+			}
+
+		private:
+			FinderT m_Finder;
+			FormatterT m_Formatter;
+			std::size_t m_MaxMatch;
+			std::basic_string<CharT> m_Tail;
+		};
+
+		//! Stream replacer generator
+		/*!
+			Construct the \c stream_replacer for a given finder and formatter.
+
+			\param Finder A Finder object used to search for a match to be replaced
+			\param Formatter A Formatter object used to format a match
+			\param MaxMatch The maximal length of a match
+			\return An instance of the \c stream_replacer
+		*/
+		template<typename CharT, typename FinderT, typename FormatterT>
+		inline stream_replacer<CharT, FinderT, FormatterT>
+			make_stream_replacer(FinderT Finder, FormatterT Formatter, std::size_t MaxMatch)
+		{
+			return stream_replacer<CharT, FinderT, FormatterT>(Finder, Formatter, MaxMatch);
+		}
+
+		//! Stream replacer generator
+		/*!
+			\overload
+
+			The maximal length of a match is taken from the finder.
+		*/
+		template<typename CharT, typename FinderT, typename FormatterT>
+			requires detail::bounded_match_finder<FinderT>
+		inline stream_replacer<CharT, FinderT, FormatterT>
+			make_stream_replacer(FinderT Finder, FormatterT Formatter)
+		{
+			return stream_replacer<CharT, FinderT, FormatterT>(Finder, Formatter);
+		}
+
+	} // namespace algorithm
+
+	// pull names to the boost namespace
+	using algorithm::stream_replacer;
+	using algorithm::make_stream_replacer;
+
+} // namespace string_algo
+
+
+#endif  // STRING_STREAM_REPLACER_HPP
@@ -11,9 +11,17 @@
 #include "predicate.hpp"
 #include "find.hpp"
 #include "split.hpp"
+#include "line_iterator.hpp"
 #include "join.hpp"
 #include "replace.hpp"
-//#include <boost/algorithm/string/erase.hpp>
+#include "stream_replacer.hpp"
+#include "replace_batch.hpp"
+#include "erase.hpp"
+#include "escape.hpp"
+#include "template_expander.hpp"
+#include "translate.hpp"
+#include "utf8_case.hpp"
+#include "ihash.hpp"
 //#include <boost/algorithm/string/classification.hpp>
 //#include <boost/algorithm/string/find_iterator.hpp>
 
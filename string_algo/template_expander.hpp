@@ -0,0 +1,354 @@
+
+#ifndef STRING_TEMPLATE_EXPANDER_HPP
+#define STRING_TEMPLATE_EXPANDER_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "as_literal.hpp"
+#include "detail/sequence.hpp"
+
+/*! \file
+	Defines the \c template_expander. A template with ${name} placeholders
+	is parsed once, each expansion then writes the literal text and the values
+	of the placeholders directly to an output of the exact size.
+*/
+
+namespace string_algo {
+	namespace algorithm {
+
+		//  template_expander  -------------------------------------------//
+
+		//! Template placeholder expander
+		/*!
+			Parses a template like <tt>"Hello ${user}, id=${id}"</tt> into literal
+			and slot segments. The template is copied, the expander does not refer
+			to the original string.
+
+			Syntax: <tt>${name}</tt> is a placeholder and <tt>$$</tt> stands for a single
+			<tt>$</tt>. A <tt>$</tt> which does not start a placeholder, an empty
+			<tt>${}</tt> and an unterminated <tt>${</tt> are literal text.
+
+			An expansion invokes the lookup callback once for every distinct name,
+			in the order of their first occurrence. The callback returns the value
+			of the placeholder as a string, a string view or a pointer to a null
+			terminated string. A null pointer (e.g. \c std::getenv of an unset
+			variable) expands to an empty value. The size of the result is computed
+			from the values, the output is resized once and filled directly.
+		*/
+		template<typename CharT>
+		class template_expander
+		{
+		public:
+			// typedefs
+			typedef CharT char_type;
+			typedef std::basic_string_view<CharT> view_type;
+
+		public:
+			//! Constructor
+			/*!
+				\param Template The template to be parsed
+			*/
+			explicit template_expander(view_type Template)
+			{
+				parse(Template);
+			}
+
+			//! Number of distinct placeholder names
+			std::size_t size() const { return m_Names.size(); }
+
+			//! The name of a placeholder
+			/*!
+				\param Index Index of the name, names are numbered in the order
+					of their first occurrence in the template
+			*/
+			view_type name(std::size_t Index) const
+			{
+				return view_type(m_Storage.data() + m_Names[Index].Offset, m_Names[Index].Size);
+			}
+
+			//! Expand the template, append variant
+			/*!
+				The result is appended to the output sequence.
+
+				\param Output A sequence to append the result to
+				\param Lookup A callback, which returns the value of a placeholder
+					for its name
+			*/
+			template<typename SequenceT, typename LookupT>
+			void expand_to(SequenceT& Output, LookupT Lookup) const
+			{
+				with_values(Lookup,
+					[&](const auto* Values)
+					{
+						std::size_t Size = m_LiteralSize;
+						for (std::size_t Index = 0; Index < m_Names.size(); ++Index)
+						{
+							Size += m_Names[Index].Count * view_type(Values[Index]).size();
+						}
+
+						if constexpr (detail::is_contiguous_sequence<SequenceT>::value)
+						{
+							std::size_t Offset = std::ranges::size(Output);
+							detail::resize_and_fill(Output, Offset + Size,
+								[&](CharT* Data)
+								{
+									write(Data + Offset, Values);
+								});
+						}
+						else
+						{
+							detail::reserve(Output, std::ranges::size(Output) + Size);
+							write(std::back_inserter(Output), Values);
+						}
+					});
+			}
+
+			//! Expand the template, copy variant
+			/*!
+				\param Output An output iterator to which the result will be copied
+				\param Lookup A callback, which returns the value of a placeholder
+					for its name
+				\return An output iterator pointing just after the last inserted character
+			*/
+			template<typename OutputIteratorT, typename LookupT>
+			OutputIteratorT expand_copy(OutputIteratorT Output, LookupT Lookup) const
+			{
+				with_values(Lookup,
+					[&](const auto* Values)
+					{
+						Output = write(Output, Values);
+					});
+				return Output;
+			}
+
+			//! Expand the template
+			/*!
+				\param Lookup A callback, which returns the value of a placeholder
+					for its name
+				\return The expanded template
+			*/
+			template<typename LookupT>
+			std::basic_string<CharT> expand(LookupT Lookup) const
+			{
+				std::basic_string<CharT> Output;
+				expand_to(Output, Lookup);
+				return Output;
+			}
+
+		private:
+			static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+			// Number of values resolved without allocation
+			static constexpr std::size_t local_values = 8;
+
+			// A literal (Slot==npos) or a placeholder
+			struct segment
+			{
+				std::size_t Offset;
+				std::size_t Size;
+				std::size_t Slot;
+			};
+
+			// A distinct placeholder name
+			struct slot_name
+			{
+				std::size_t Offset;
+				std::size_t Size;
+				std::size_t Count;
+			};
+
+			void parse(view_type Template)
+			{
+				m_LiteralSize = 0;
+				m_Storage.reserve(Template.size());
+
+				std::size_t Pos = 0;
+				while (Pos < Template.size())
+				{
+					std::size_t Dollar = Template.find(static_cast<CharT>('$'), Pos);
+					if (Dollar == view_type::npos)
+					{
+						add_literal(Template.substr(Pos));
+						break;
+					}
+
+					if (Dollar + 1 < Template.size() && Template[Dollar + 1] == static_cast<CharT>('$'))
+					{
+						// "$$" stands for "$"
+						add_literal(Template.substr(Pos, Dollar + 1 - Pos));
+						Pos = Dollar + 2;
+						continue;
+					}
+
+					// The name ends at the first '}', it does not contain '$' or '{'
+					std::size_t Close = view_type::npos;
+					if (Dollar + 1 < Template.size() && Template[Dollar + 1] == static_cast<CharT>('{'))
+					{
+						const CharT Delimiters[] = { static_cast<CharT>('}'), static_cast<CharT>('$'), static_cast<CharT>('{') };
+						Close = Template.find_first_of(view_type(Delimiters, 3), Dollar + 2);
+					}
+
+					if (Close == view_type::npos || Template[Close] != static_cast<CharT>('}') || Close == Dollar + 2)
+					{
+						// Not a placeholder
+						add_literal(Template.substr(Pos, Dollar + 1 - Pos));
+						Pos = Dollar + 1;
+						continue;
+					}
+
+					add_literal(Template.substr(Pos, Dollar - Pos));
+					add_slot(Template.substr(Dollar + 2, Close - Dollar - 2));
+					Pos = Close + 1;
+				}
+			}
+
+			void add_literal(view_type Text)
+			{
+				if (Text.empty()) return;
+
+				if (!m_Segments.empty() && m_Segments.back().Slot == npos &&
+					m_Segments.back().Offset + m_Segments.back().Size == m_Storage.size())
+				{
+					// Merge with the preceding literal
+					m_Segments.back().Size += Text.size();
+				}
+				else
+				{
+					m_Segments.push_back(segment{ m_Storage.size(), Text.size(), npos });
+				}
+
+				m_Storage.append(Text.data(), Text.size());
+				m_LiteralSize += Text.size();
+			}
+
+			void add_slot(view_type Name)
+			{
+				std::size_t Slot = 0;
+				for (; Slot < m_Names.size(); ++Slot)
+				{
+					if (name(Slot) == Name) break;
+				}
+
+				if (Slot == m_Names.size())
+				{
+					m_Names.push_back(slot_name{ m_Storage.size(), Name.size(), 0 });
+					m_Storage.append(Name.data(), Name.size());
+				}
+
+				++m_Names[Slot].Count;
+				m_Segments.push_back(segment{ 0, 0, Slot });
+			}
+
+			// Convert a lookup result to a value, a null pointer is an empty value
+			template<typename ValueT, typename ResultT>
+			static ValueT make_value(ResultT&& Result)
+			{
+				if constexpr (std::is_pointer_v<std::remove_cvref_t<ResultT>>)
+				{
+					return Result ? ValueT(Result) : ValueT();
+				}
+				else
+				{
+					return ValueT(std::forward<ResultT>(Result));
+				}
+			}
+
+			// Resolve the values of all names and invoke Fn(Values)
+			/*
+				Values returned by reference or as views are kept as views, other
+				results (e.g. strings returned by value) are stored.
+			*/
+			template<typename LookupT, typename FunctionT>
+			void with_values(LookupT& Lookup, FunctionT Fn) const
+			{
+				typedef std::invoke_result_t<LookupT&, view_type> result_type;
+				typedef std::remove_cvref_t<result_type> decayed_type;
+				typedef std::conditional_t<
+					std::is_lvalue_reference_v<result_type> ||
+					std::is_same_v<decayed_type, view_type> ||
+					std::is_pointer_v<decayed_type>,
+					view_type,
+					decayed_type> value_type;
+
+				if (m_Names.size() <= local_values)
+				{
+					std::array<value_type, local_values> Values{};
+					for (std::size_t Index = 0; Index < m_Names.size(); ++Index)
+					{
+						Values[Index] = make_value<value_type>(std::invoke(Lookup, name(Index)));
+					}
+					Fn(Values.data());
+				}
+				else
+				{
+					std::vector<value_type> Values;
+					Values.reserve(m_Names.size());
+					for (std::size_t Index = 0; Index < m_Names.size(); ++Index)
+					{
+						Values.push_back(make_value<value_type>(std::invoke(Lookup, name(Index))));
+					}
+					Fn(Values.data());
+				}
+			}
+
+			template<typename OutputIteratorT, typename ValueT>
+			OutputIteratorT write(OutputIteratorT Output, const ValueT* Values) const
+			{
+				for (const segment& Segment : m_Segments)
+				{
+					view_type Text = (Segment.Slot == npos)
+						? view_type(m_Storage.data() + Segment.Offset, Segment.Size)
+						: view_type(Values[Segment.Slot]);
+
+					Output = std::copy(Text.begin(), Text.end(), Output);
+				}
+				return Output;
+			}
+
+		private:
+			std::basic_string<CharT> m_Storage;
+			std::vector<segment> m_Segments;
+			std::vector<slot_name> m_Names;
+			std::size_t m_LiteralSize;
+		};
+
+		//! Template expansion
+		/*!
+			Parse a template and expand it with the given lookup callback.
+			Use the \c template_expander to expand a template repeatedly.
+
+			\param Template A template with ${name} placeholders
+			\param Lookup A callback, which returns the value of a placeholder
+				for its name
+			\return The expanded template
+		*/
+		template<typename RangeT, typename LookupT>
+		inline auto expand_template(const RangeT& Template, LookupT Lookup)
+		{
+			auto lit_template = ::string_algo::as_literal(Template);
+			typedef std::remove_const_t<typename decltype(lit_template)::element_type> char_type;
+
+			return template_expander<char_type>(
+				std::basic_string_view<char_type>(lit_template.data(), lit_template.size())).expand(Lookup);
+		}
+
+	} // namespace algorithm
+
+	// pull names to the boost namespace
+	using algorithm::template_expander;
+	using algorithm::expand_template;
+
+} // namespace string_algo
+
+
+#endif  // STRING_TEMPLATE_EXPANDER_HPP
@@ -0,0 +1,212 @@
+
+#ifndef STRING_TOKEN_COLUMNS_HPP
+#define STRING_TOKEN_COLUMNS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+/*! \file
+	Defines the \c token_columns container. It is a columnar (structure of arrays)
+	alternative to a 'container of containers' as a result of split and find_all
+	algorithms. Tokens are stored as two contiguous arrays of offsets and lengths
+	into the input, views of the tokens are created on demand.
+*/
+
+namespace string_algo {
+	namespace algorithm {
+
+		//  token_columns  -----------------------------------------------//
+
+		//! Columnar token container
+		/*!
+			Stores tokens found in an input sequence as a pair of offset and length
+			arrays. Unlike a container of strings, no memory is allocated for individual
+			tokens and the data stays dense for later scans.
+
+			The container refers to the input it was filled from. The input must
+			outlive the container, or at least every access to the token views.
+
+			\c OffsetT selects the width of the stored offsets and lengths. The default
+			32-bit offsets take 8 bytes per token and can address inputs below 4 GiB.
+			Use \c std::uint64_t for larger inputs.
+		*/
+		template<typename CharT, typename OffsetT = std::uint32_t>
+		class token_columns
+		{
+		public:
+			// typedefs
+			typedef CharT char_type;
+			typedef OffsetT offset_type;
+			typedef std::basic_string_view<CharT> value_type;
+			typedef std::size_t size_type;
+			typedef std::ptrdiff_t difference_type;
+
+			//! Random access iterator yielding token views
+			class const_iterator
+			{
+			public:
+				typedef std::random_access_iterator_tag iterator_category;
+				typedef typename token_columns::value_type value_type;
+				typedef std::ptrdiff_t difference_type;
+				typedef const value_type* pointer;
+				typedef value_type reference;
+
+				const_iterator() : m_Columns(nullptr), m_Index(0) {}
+				const_iterator(const token_columns* Columns, size_type Index) :
+					m_Columns(Columns), m_Index(Index) {}
+
+				value_type operator*() const { return (*m_Columns)[m_Index]; }
+				value_type operator[](difference_type N) const { return (*m_Columns)[m_Index + N]; }
+
+				const_iterator& operator++() { ++m_Index; return *this; }
+				const_iterator operator++(int) { const_iterator Tmp(*this); ++m_Index; return Tmp; }
+				const_iterator& operator--() { --m_Index; return *this; }
+				const_iterator operator--(int) { const_iterator Tmp(*this); --m_Index; return Tmp; }
+				const_iterator& operator+=(difference_type N) { m_Index += N; return *this; }
+				const_iterator& operator-=(difference_type N) { m_Index -= N; return *this; }
+
+				friend const_iterator operator+(const_iterator It, difference_type N) { return It += N; }
+				friend const_iterator operator+(difference_type N, const_iterator It) { return It += N; }
+				friend const_iterator operator-(const_iterator It, difference_type N) { return It -= N; }
+				friend difference_type operator-(const const_iterator& Lhs, const const_iterator& Rhs)
+				{
+					return static_cast<difference_type>(Lhs.m_Index) - static_cast<difference_type>(Rhs.m_Index);
+				}
+
+				friend bool operator==(const const_iterator& Lhs, const const_iterator& Rhs) { return Lhs.m_Index == Rhs.m_Index; }
+				friend auto operator<=>(const const_iterator& Lhs, const const_iterator& Rhs) { return Lhs.m_Index <=> Rhs.m_Index; }
+
+			private:
+				const token_columns* m_Columns;
+				size_type m_Index;
+			};
+			typedef const_iterator iterator;
+
+		public:
+			//! Default constructor
+			/*!
+				Construct an empty container not bound to any input
+			*/
+			token_columns() : m_Base(nullptr) {}
+
+			//! Bind the container to an input
+			/*!
+				Removes all tokens and sets the input the offsets refer to.
+
+				\param Base The beginning of the input
+				\param Size The size of the input
+				\throw std::length_error if the input cannot be addressed by \c OffsetT
+			*/
+			void assign_input(const CharT* Base, size_type Size)
+			{
+				if (Size > static_cast<size_type>((std::numeric_limits<OffsetT>::max)()))
+				{
+					throw std::length_error("token_columns: input is too large for the offset type");
+				}
+
+				clear();
+				m_Base = Base;
+			}
+
+			//! Append a token
+			/*!
+				\param Offset An offset of the token from the beginning of the input
+				\param Length The length of the token
+			*/
+			void push_back(size_type Offset, size_type Length)
+			{
+				m_Offsets.push_back(static_cast<OffsetT>(Offset));
+				m_Lengths.push_back(static_cast<OffsetT>(Length));
+			}
+
+			//! Resize the columns
+			/*!
+				New tokens are empty and located at the beginning of the input.
+			*/
+			void resize(size_type Count)
+			{
+				m_Offsets.resize(Count);
+				m_Lengths.resize(Count);
+			}
+
+			//! Set a token
+			void set(size_type Index, size_type Offset, size_type Length)
+			{
+				m_Offsets[Index] = static_cast<OffsetT>(Offset);
+				m_Lengths[Index] = static_cast<OffsetT>(Length);
+			}
+
+			//! Reserve space for tokens
+			void reserve(size_type Count)
+			{
+				m_Offsets.reserve(Count);
+				m_Lengths.reserve(Count);
+			}
+
+			//! Remove all tokens
+			/*!
+				The binding to the input is preserved.
+			*/
+			void clear()
+			{
+				m_Offsets.clear();
+				m_Lengths.clear();
+			}
+
+			// Size
+			size_type size() const { return m_Offsets.size(); }
+			bool empty() const { return m_Offsets.empty(); }
+
+			// Columns
+			const std::vector<OffsetT>& offsets() const { return m_Offsets; }
+			const std::vector<OffsetT>& lengths() const { return m_Lengths; }
+			size_type offset(size_type Index) const { return m_Offsets[Index]; }
+			size_type length(size_type Index) const { return m_Lengths[Index]; }
+
+			//! The beginning of the bound input
+			const CharT* data() const { return m_Base; }
+
+			//! Create a view of a token
+			value_type operator[](size_type Index) const
+			{
+				return value_type(m_Base + m_Offsets[Index], m_Lengths[Index]);
+			}
+
+			// Iteration
+			const_iterator begin() const { return const_iterator(this, 0); }
+			const_iterator end() const { return const_iterator(this, size()); }
+
+		private:
+			const CharT* m_Base;
+			std::vector<OffsetT> m_Offsets;
+			std::vector<OffsetT> m_Lengths;
+		};
+
+		namespace detail {
+
+//  split engine support  ------------------------------------------------//
+
+			// Check that a result type is a token_columns
+			template<typename T>
+			struct is_token_columns : std::false_type {};
+
+			template<typename CharT, typename OffsetT>
+			struct is_token_columns< token_columns<CharT, OffsetT> > : std::true_type {};
+
+		} // namespace detail
+
+	} // namespace algorithm
+
+	// pull names to the boost namespace
+	using algorithm::token_columns;
+
+} // namespace string_algo
+
+
+#endif  // STRING_TOKEN_COLUMNS_HPP
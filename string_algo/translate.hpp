@@ -0,0 +1,171 @@
+
+#ifndef STRING_TRANSLATE_HPP
+#define STRING_TRANSLATE_HPP
+
+#include "as_literal.hpp"
+#include "detail/translate.hpp"
+
+/*! \file
+	Defines the tr-style \c translate and \c squeeze algorithms.
+
+	\c translate maps characters of one set to the corresponding characters
+	of another set, \c squeeze collapses runs of characters satisfying
+	a predicate. Both are single pass algorithms, byte strings are processed
+	16 bytes at a time where possible.
+*/
+
+namespace string_algo {
+	namespace algorithm {
+
+		//  translate  -------------------------------------------------//
+
+		//! Translate algorithm
+		/*!
+			Replace every character of the input, which occurs in the \c From set,
+			by the character at the same position in the \c To set. If \c To is shorter
+			than \c From, the last character of \c To is used for the rest of \c From.
+			An empty \c To leaves the input unchanged. If a character occurs in \c From
+			several times, its last occurrence counts.
+			The result is a modified copy of the input. It is returned as a sequence
+			or copied to the output iterator.
+
+			Byte strings are translated through a 256 entry table. If the translation
+			changes at most 16 characters, the input is translated 16 bytes at a time.
+
+			\param Output An output iterator to which the result will be copied
+			\param Input An input string
+			\param From A set of characters to be translated
+			\param To A set of the translations
+			\return An output iterator pointing just after the last inserted character or
+				a modified copy of the input
+		*/
+		template<typename OutputIteratorT, typename RangeT, typename Range1T, typename Range2T>
+		inline OutputIteratorT translate_copy(
+			OutputIteratorT Output,
+			const RangeT& Input,
+			const Range1T& From,
+			const Range2T& To)
+		{
+			auto lit_input = ::string_algo::as_literal(Input);
+
+			return ::string_algo::algorithm::detail::translate_copy_impl(
+				Output,
+				lit_input.data(),
+				lit_input.data() + lit_input.size(),
+				::string_algo::as_literal(From),
+				::string_algo::as_literal(To));
+		}
+
+		//! Translate algorithm
+		/*!
+			\overload
+		*/
+		template<typename SequenceT, typename Range1T, typename Range2T>
+		inline SequenceT translate_copy(
+			const SequenceT& Input,
+			const Range1T& From,
+			const Range2T& To)
+		{
+			return ::string_algo::algorithm::detail::translate_copy_impl(
+				Input,
+				::string_algo::as_literal(From),
+				::string_algo::as_literal(To));
+		}
+
+		//! Translate algorithm
+		/*!
+			Replace every character of the input, which occurs in the \c From set,
+			by the character at the same position in the \c To set.
+			The input sequence is modified in-place.
+
+			\param Input An input string
+			\param From A set of characters to be translated
+			\param To A set of the translations
+		*/
+		template<typename SequenceT, typename Range1T, typename Range2T>
+		inline void translate(
+			SequenceT& Input,
+			const Range1T& From,
+			const Range2T& To)
+		{
+			::string_algo::algorithm::detail::translate_impl(
+				Input,
+				::string_algo::as_literal(From),
+				::string_algo::as_literal(To));
+		}
+
+		//  squeeze  ---------------------------------------------------//
+
+		//! Squeeze algorithm
+		/*!
+			Collapse every run of consecutive characters satisfying the predicate
+			into its first character, e.g. <tt>squeeze_copy(s, is_space())</tt> turns
+			<tt>"a \t b"</tt> into <tt>"a b"</tt>. Other characters are kept.
+			The result is a modified copy of the input. It is returned as a sequence
+			or copied to the output iterator.
+
+			For byte character types and inputs of at least a few hundred characters,
+			the predicate is tabulated as in \c erase_if and the input is processed
+			16 bytes at a time. The predicate must depend only on its argument.
+
+			\param Output An output iterator to which the result will be copied
+			\param Input An input string
+			\param Pred A predicate selecting the characters to be squeezed
+			\return An output iterator pointing just after the last inserted character or
+				a modified copy of the input
+		*/
+		template<typename OutputIteratorT, typename RangeT, typename PredicateT>
+		inline OutputIteratorT squeeze_copy(
+			OutputIteratorT Output,
+			const RangeT& Input,
+			PredicateT Pred)
+		{
+			auto lit_input = ::string_algo::as_literal(Input);
+
+			return ::string_algo::algorithm::detail::squeeze_copy_impl(
+				Output,
+				lit_input.data(),
+				lit_input.data() + lit_input.size(),
+				Pred);
+		}
+
+		//! Squeeze algorithm
+		/*!
+			\overload
+		*/
+		template<typename SequenceT, typename PredicateT>
+		inline SequenceT squeeze_copy(
+			const SequenceT& Input,
+			PredicateT Pred)
+		{
+			return ::string_algo::algorithm::detail::squeeze_copy_impl(Input, Pred);
+		}
+
+		//! Squeeze algorithm
+		/*!
+			Collapse every run of consecutive characters satisfying the predicate
+			into its first character. The input sequence is modified in-place.
+
+			\param Input An input string
+			\param Pred A predicate selecting the characters to be squeezed
+		*/
+		template<typename SequenceT, typename PredicateT>
+		inline void squeeze(
+			SequenceT& Input,
+			PredicateT Pred)
+		{
+			::string_algo::algorithm::detail::squeeze_impl(Input, Pred);
+		}
+
+	} // namespace algorithm
+
+	// pull names to the boost namespace
+	using algorithm::translate_copy;
+	using algorithm::translate;
+	using algorithm::squeeze_copy;
+	using algorithm::squeeze;
+
+} // namespace string_algo
+
+
+#endif  // STRING_TRANSLATE_HPP
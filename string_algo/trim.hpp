@@ -19,6 +19,9 @@
 	Functions take a selection predicate as a parameter, which is used to determine
 	whether a character is a space. Common predicates are provided in classification.hpp header.
 
+	Contiguous inputs of byte characters are trimmed from both ends by the predicate,
+	long runs of spaces are skipped 16 bytes at a time by a tabulated predicate.
+
 */
 namespace string_algo
 {
@@ -0,0 +1,190 @@
+
+#ifndef STRING_UTF8_CASE_HPP
+#define STRING_UTF8_CASE_HPP
+
+#include "as_literal.hpp"
+#include "detail/utf8_case.hpp"
+
+/*! \file
+	Defines case conversion and case folding of UTF-8 strings.
+
+	Characters are mapped by the simple (one to one) case mappings of the Unicode
+	character database, looked up in compact two-stage tables. Mappings, which
+	expand a character to several, like the upper case of U+00DF, are not applied.
+	The encoded length of a character may change, e.g. U+023A (2 bytes) has
+	the lower case U+2C65 (3 bytes). The size of the result is computed by
+	a pre-pass, so the output is allocated once.
+
+	Runs of ASCII characters are converted 16 bytes at a time. Invalid UTF-8
+	sequences are copied unchanged.
+
+	The algorithms are defined in the \c utf8 namespace, so they do not collide
+	with the locale based \c to_lower and \c to_upper.
+*/
+
+namespace string_algo {
+	namespace algorithm {
+		namespace utf8 {
+
+			//  to_lower  -----------------------------------------------//
+
+			//! Convert to lower case
+			/*!
+				Each character of the input is mapped to its simple lower case mapping.
+				The result is a modified copy of the input. It is returned as a sequence
+				or copied to the output iterator.
+
+				\param Output An output iterator to which the result will be copied
+				\param Input A UTF-8 input string
+				\return An output iterator pointing just after the last inserted character or
+					a modified copy of the input
+			*/
+			template<typename OutputIteratorT, typename RangeT>
+			inline OutputIteratorT to_lower_copy(
+				OutputIteratorT Output,
+				const RangeT& Input)
+			{
+				auto lit_input = ::string_algo::as_literal(Input);
+
+				return ::string_algo::algorithm::detail::utf8_case_copy<::string_algo::algorithm::detail::utf8_lower>(
+					Output,
+					lit_input.data(),
+					lit_input.data() + lit_input.size());
+			}
+
+			//! Convert to lower case
+			/*!
+				\overload
+			*/
+			template<typename SequenceT>
+			inline SequenceT to_lower_copy(const SequenceT& Input)
+			{
+				return ::string_algo::algorithm::detail::utf8_case_sequence_copy<::string_algo::algorithm::detail::utf8_lower>(Input);
+			}
+
+			//! Convert to lower case
+			/*!
+				Each character of the input is mapped to its simple lower case mapping.
+				The input sequence is modified in-place. If the lengths of the encodings
+				change, the sequence is rebuilt.
+
+				\param Input A UTF-8 input string
+			*/
+			template<typename SequenceT>
+			inline void to_lower(SequenceT& Input)
+			{
+				::string_algo::algorithm::detail::utf8_case_impl<::string_algo::algorithm::detail::utf8_lower>(Input);
+			}
+
+			//  to_upper  -----------------------------------------------//
+
+			//! Convert to upper case
+			/*!
+				Each character of the input is mapped to its simple upper case mapping.
+				The result is a modified copy of the input. It is returned as a sequence
+				or copied to the output iterator.
+
+				\param Output An output iterator to which the result will be copied
+				\param Input A UTF-8 input string
+				\return An output iterator pointing just after the last inserted character or
+					a modified copy of the input
+			*/
+			template<typename OutputIteratorT, typename RangeT>
+			inline OutputIteratorT to_upper_copy(
+				OutputIteratorT Output,
+				const RangeT& Input)
+			{
+				auto lit_input = ::string_algo::as_literal(Input);
+
+				return ::string_algo::algorithm::detail::utf8_case_copy<::string_algo::algorithm::detail::utf8_upper>(
+					Output,
+					lit_input.data(),
+					lit_input.data() + lit_input.size());
+			}
+
+			//! Convert to upper case
+			/*!
+				\overload
+			*/
+			template<typename SequenceT>
+			inline SequenceT to_upper_copy(const SequenceT& Input)
+			{
+				return ::string_algo::algorithm::detail::utf8_case_sequence_copy<::string_algo::algorithm::detail::utf8_upper>(Input);
+			}
+
+			//! Convert to upper case
+			/*!
+				Each character of the input is mapped to its simple upper case mapping.
+				The input sequence is modified in-place. If the lengths of the encodings
+				change, the sequence is rebuilt.
+
+				\param Input A UTF-8 input string
+			*/
+			template<typename SequenceT>
+			inline void to_upper(SequenceT& Input)
+			{
+				::string_algo::algorithm::detail::utf8_case_impl<::string_algo::algorithm::detail::utf8_upper>(Input);
+			}
+
+			//  fold_case  -----------------------------------------------//
+
+			//! Case folding
+			/*!
+				Each character of the input is mapped to its simple case folding.
+				Folded strings compare equal, if the originals differ only in case.
+				The result is a modified copy of the input. It is returned as a sequence
+				or copied to the output iterator.
+
+				\param Output An output iterator to which the result will be copied
+				\param Input A UTF-8 input string
+				\return An output iterator pointing just after the last inserted character or
+					a modified copy of the input
+			*/
+			template<typename OutputIteratorT, typename RangeT>
+			inline OutputIteratorT fold_case_copy(
+				OutputIteratorT Output,
+				const RangeT& Input)
+			{
+				auto lit_input = ::string_algo::as_literal(Input);
+
+				return ::string_algo::algorithm::detail::utf8_case_copy<::string_algo::algorithm::detail::utf8_fold>(
+					Output,
+					lit_input.data(),
+					lit_input.data() + lit_input.size());
+			}
+
+			//! Case folding
+			/*!
+				\overload
+			*/
+			template<typename SequenceT>
+			inline SequenceT fold_case_copy(const SequenceT& Input)
+			{
+				return ::string_algo::algorithm::detail::utf8_case_sequence_copy<::string_algo::algorithm::detail::utf8_fold>(Input);
+			}
+
+			//! Case folding
+			/*!
+				Each character of the input is mapped to its simple case folding.
+				Folded strings compare equal, if the originals differ only in case.
+				The input sequence is modified in-place. If the lengths of the encodings
+				change, the sequence is rebuilt.
+
+				\param Input A UTF-8 input string
+			*/
+			template<typename SequenceT>
+			inline void fold_case(SequenceT& Input)
+			{
+				::string_algo::algorithm::detail::utf8_case_impl<::string_algo::algorithm::detail::utf8_fold>(Input);
+			}
+
+		} // namespace utf8
+	} // namespace algorithm
+
+	// pull names to the boost namespace
+	namespace utf8 = algorithm::utf8;
+
+} // namespace string_algo
+
+
+#endif  // STRING_UTF8_CASE_HPP